@@ -0,0 +1,12 @@
+#ifndef HOST_AVR_INTERRUPT_H
+#define HOST_AVR_INTERRUPT_H
+
+//native build stand-in for <avr/interrupt.h>
+//an ISR is a plain function the runner calls, e.g. TIMER2_COMPA_vect() or USART_RX_vect()
+#include "../host_hw.h"
+
+#define ISR(vector) void vector(void)
+#define sei() (SREG |= 0x80)
+#define cli() (SREG &= ~0x80)
+
+#endif /* HOST_AVR_INTERRUPT_H */
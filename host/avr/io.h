@@ -0,0 +1,7 @@
+#ifndef HOST_AVR_IO_H
+#define HOST_AVR_IO_H
+
+//native build stand-in for <avr/io.h>, registers are emulated in host_hw.h
+#include "../host_hw.h"
+
+#endif /* HOST_AVR_IO_H */
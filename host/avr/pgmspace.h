@@ -0,0 +1,13 @@
+#ifndef HOST_AVR_PGMSPACE_H
+#define HOST_AVR_PGMSPACE_H
+
+//native build stand-in for <avr/pgmspace.h>, flash and RAM are the same address space here
+#include <stdint.h>
+
+#define PROGMEM
+#define PSTR(s) (s)
+#define pgm_read_byte(addr) (*(const uint8_t *)(addr))
+#define pgm_read_word(addr) (*(const uint16_t *)(addr))
+#define pgm_read_ptr(addr) (*(const void *const *)(addr))
+
+#endif /* HOST_AVR_PGMSPACE_H */
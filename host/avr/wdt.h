@@ -0,0 +1,42 @@
+#ifndef HOST_AVR_WDT_H
+#define HOST_AVR_WDT_H
+
+//native build stand-in for <avr/wdt.h>, the watchdog never fires here
+//host_sim deadline stands in for the reset by moving the .noinit record to a fresh core
+//while it is on, every kick records the gap since the last one on the board's clock, emulated
+//time plus the panel bus and the UART and EEPROM waits. host_sim watchdog holds it to the timeout
+#include "../host_hw.h"
+
+#define WDTO_250MS 4
+#define WDTO_500MS 5
+#define WDTO_1S 6
+#define HOST_WDT_US(timeout) (16000ULL << (timeout)) //nominal, the part's own oscillator is +-10%
+
+inline thread_local uint8_t host_wdt_timeout = 0xFF; //WDTO_ value, 0xFF while off
+inline thread_local unsigned long host_wdt_kicks = 0;
+inline thread_local unsigned long long host_wdt_last = 0; //board time of the last kick
+inline thread_local unsigned long long host_wdt_gap = 0;  //longest gap between kicks while on
+
+inline unsigned long long host_wdt_now(){
+    return host_time_us + host_bus_us + host_wait_us;
+}
+
+inline void wdt_enable(uint8_t timeout){
+    host_wdt_timeout = timeout;
+    host_wdt_last = host_wdt_now();
+}
+
+inline void wdt_disable(){
+    host_wdt_timeout = 0xFF;
+}
+
+inline void wdt_reset(){
+    unsigned long long now = host_wdt_now();
+    if (host_wdt_timeout != 0xFF && now - host_wdt_last > host_wdt_gap){
+        host_wdt_gap = now - host_wdt_last;
+    }
+    host_wdt_last = now;
+    host_wdt_kicks++;
+}
+
+#endif /* HOST_AVR_WDT_H */
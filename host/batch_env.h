@@ -0,0 +1,247 @@
+#ifndef HOST_BATCH_ENV_H
+#define HOST_BATCH_ENV_H
+
+//BATCHED ENVIRONMENT
+//N independent birds and levels stepped together for training policies against the game
+//state is one array per field (structure of arrays) so the per-tick physics and collision
+//loop is straight-line integer code the compiler vectorizes across birds
+//
+//a step is one scheduler cycle of a PLAYING game, ticking the same rules as the core:
+//TickButtons edge detection, TickPosition, TickDeath, then TickLevel's scroll, score and
+//refresh_pipe, all in the task table's order
+//
+//  batch_init(env, n)                 allocate n lanes, all done
+//  batch_reset(env, k, seed)          lane k starts seed's level, like a reset + tap to play
+//  batch_step(env, actions)           actions[k] is the jump button level, done lanes are skipped
+//  batch_observe(env, obs)            BATCH_OBS features per lane, feature-major (obs[f * n + k])
+//
+//host_batch check steps the scalar core next to a lane per seed and compares every tick
+
+#include "game.h"
+#include <vector>
+
+//a level is a ring of pipe slots, one per PIPE_SPACING columns, slot s at column s * PIPE_SPACING
+#define BATCH_SLOTS (LEVEL_SIZE / PIPE_SPACING)
+static_assert(LEVEL_SIZE % PIPE_SPACING == 0, "pipe slots must tile the level");
+static_assert(PLAYER_OFFSET == PIPE_SPACING - 1, "refresh_pipe must land on a pipe column");
+static_assert(PLAYER_SIZE / 2 < PIPE_SPACING / 2, "collision window may only reach one pipe");
+static_assert(SCROLL_RAMP == 0, "lanes scroll one column a tick, leave scroll_ramp at 0 for check");
+
+enum BATCH_MODE {BATCH_FALLING, BATCH_JUMPING, BATCH_FREEZE};
+
+//observation features
+enum BATCH_OBS_FEATURE {
+    BATCH_OBS_HEIGHT,    //bird centre, 0 floor .. 128 ceiling
+    BATCH_OBS_VELOCITY,  //height change of the last tick
+    BATCH_OBS_DISTANCE,  //columns until the next pipe's centre passes the bird
+    BATCH_OBS_BOTTOM,    //next pipe's bottom
+    BATCH_OBS_TOP,       //next pipe's bottom + gap
+    BATCH_OBS_HANG,      //ticks of ascent left, 0 while falling
+    BATCH_OBS
+};
+
+struct batch_env {
+    int n;
+
+    //bird, one entry per lane
+    std::vector<int32_t> height;
+    std::vector<int32_t> speed;    //TickPosition's speed, only meaningful while falling
+    std::vector<int32_t> cnt;      //TickPosition's cnt
+    std::vector<int32_t> mode;     //BATCH_MODE
+    std::vector<int32_t> button;   //jump level last tick, TickButtons only jumps on a new press
+    std::vector<int32_t> last_dh;
+
+    //level, TickLevel's i and frame, pipe bottoms per slot
+    std::vector<int32_t> i;
+    std::vector<int32_t> frame;
+    std::vector<int32_t> bottom[BATCH_SLOTS];
+    std::vector<int32_t> has_pipe[BATCH_SLOTS];
+    std::vector<unsigned long> rng;
+
+    //run
+    std::vector<int32_t> score;
+    std::vector<int32_t> reward;   //points scored by the last step
+    std::vector<int32_t> done;
+    std::vector<int32_t> refresh;  //scratch, lanes whose pipe behind the bird needs a new bottom
+    std::vector<int32_t> steps;    //steps since reset, the death step included
+};
+
+void batch_init(struct batch_env *env, int n){
+    env->n = n;
+    std::vector<int32_t> *fields[] = {&env->height, &env->speed, &env->cnt, &env->mode, &env->button,
+        &env->last_dh, &env->i, &env->frame, &env->score, &env->reward, &env->done, &env->refresh, &env->steps};
+    for (std::vector<int32_t> *f : fields){
+        f->assign(n, 0);
+    }
+    for (int s = 0; s < BATCH_SLOTS; s++){
+        env->bottom[s].assign(n, -1);
+        env->has_pipe[s].assign(n, 0);
+    }
+    env->rng.assign(n, 1);
+    env->done.assign(n, 1);
+}
+
+//create_level from seed, then the state TickMenu/TickPosition/TickLevel leave on the paused screen
+//the first step ticks FREEZE into FALLING, so a jump on it is dropped like on the board
+void batch_reset(struct batch_env *env, int k, unsigned long seed){
+    env->rng[k] = seed;
+    for (int s = 0; s < BATCH_SLOTS; s++){
+        env->has_pipe[s][k] = (s != 0); //column 0 gets its pipe from the first refresh_pipe
+        env->bottom[s][k] = (s != 0) ? rng_next_from(&env->rng[k]) % (GAP_MAX - GAP_MIN + 1) + GAP_MIN : -1;
+    }
+    env->height[k] = START_HEIGHT;
+    env->speed[k] = 0;
+    env->cnt[k] = 0;
+    env->mode[k] = BATCH_FREEZE;
+    env->button[k] = 0;
+    env->last_dh[k] = 0;
+    env->i[k] = 0;
+    env->frame[k] = 0;
+    env->score[k] = 0;
+    env->reward[k] = 0;
+    env->done[k] = 0;
+    env->steps[k] = 0;
+}
+
+//mask ? a : b with an all ones/zeros mask
+inline int32_t batch_pick(int32_t mask, int32_t a, int32_t b){
+    return (a & mask) | (b & ~mask);
+}
+
+void batch_step(struct batch_env *env, const int32_t *actions){
+    const int n = env->n;
+    int32_t *__restrict height = env->height.data();
+    int32_t *__restrict speed = env->speed.data();
+    int32_t *__restrict cnt = env->cnt.data();
+    int32_t *__restrict mode = env->mode.data();
+    int32_t *__restrict button = env->button.data();
+    int32_t *__restrict last_dh = env->last_dh.data();
+    int32_t *__restrict li = env->i.data();
+    int32_t *__restrict frame = env->frame.data();
+    int32_t *__restrict score = env->score.data();
+    int32_t *__restrict reward = env->reward.data();
+    int32_t *__restrict done = env->done.data();
+    int32_t *__restrict refresh = env->refresh.data();
+    int32_t *__restrict steps = env->steps.data();
+    const int32_t *__restrict bottom[BATCH_SLOTS];
+    const int32_t *__restrict has_pipe[BATCH_SLOTS];
+    for (int s = 0; s < BATCH_SLOTS; s++){
+        bottom[s] = env->bottom[s].data();
+        has_pipe[s] = env->has_pipe[s].data();
+    }
+    int any_refresh = 0;
+
+    //branch free across lanes, every rule is a select so the loop vectorizes
+    //lanes never touch each other's entries, ivdep saves the alias checks between the arrays
+    #pragma GCC ivdep
+    for (int k = 0; k < n; k++){
+        int32_t live = !done[k];
+        int32_t press = actions[k] != 0;
+        int32_t jump = press & !button[k];
+
+        //TickPosition transitions
+        int32_t m = mode[k], c = cnt[k], sp = speed[k];
+        int32_t jumping = (m == BATCH_JUMPING);
+        int32_t landed = jumping & (c >= JUMP_HANGTIME);
+        int32_t next_jumping = (m == BATCH_FALLING) ? jump
+                             : (m == BATCH_FREEZE) ? (c != 0)
+                             : !landed;
+        c = (jumping & !landed & jump) ? 0 : c;
+        c = landed ? 0 : c;
+        sp = landed ? 0 : sp;
+
+        //TickPosition actions
+        int32_t fall_speed = sp + FALL_ACCEL;
+        int32_t dh = next_jumping ? JUMP_VERTICAL : -fall_speed;
+        int32_t h = height[k] + dh;
+        c = next_jumping ? c + 1 : c;
+        sp = next_jumping ? sp : fall_speed;
+
+        //TickDeath, the columns within PLAYER_SIZE/2 of frame hold at most one pipe
+        //its band check is stricter than the curr_column one, so that one never decides
+        int32_t f = frame[k];
+        int32_t out = (h < 0) | (128 < h);
+        int32_t hit = 0;
+        #pragma GCC unroll 16
+        for (int s = 0; s < BATCH_SLOTS; s++){
+            int32_t d = (f - s * PIPE_SPACING + LEVEL_SIZE + LEVEL_SIZE / 2) % LEVEL_SIZE - LEVEL_SIZE / 2;
+            int32_t near = (d >= -PLAYER_SIZE/2) & (d <= PLAYER_SIZE/2);
+            int32_t b = bottom[s][k];
+            int32_t clear = (h - PLAYER_SIZE/4 + 1 >= b) & (b + GAP >= h + PLAYER_SIZE/4);
+            hit |= near & has_pipe[s][k] & !clear;
+        }
+        int32_t dead = out | hit;
+        h = out ? 64 : h;
+
+        //TickLevel, a dead bird's menu resets before the level scrolls
+        int32_t i = li[k];
+        int32_t scroll = live & !dead;
+        int32_t scored = scroll & (i % PIPE_SPACING == 1);
+        int32_t renew = scroll & (i % PIPE_SPACING == PIPE_SPACING - 1);
+
+        //written back through masks, a select on the old value becomes a branchy conditional store
+        int32_t keep = live - 1, moved = -scroll; //all ones/zeros
+        height[k] = batch_pick(keep, height[k], h);
+        cnt[k] = batch_pick(keep, cnt[k], c);
+        speed[k] = batch_pick(keep, speed[k], sp);
+        mode[k] = batch_pick(keep, mode[k], next_jumping ? BATCH_JUMPING : BATCH_FALLING);
+        button[k] = batch_pick(keep, button[k], press);
+        last_dh[k] = batch_pick(keep, last_dh[k], dh);
+        frame[k] = batch_pick(moved, i, frame[k]);
+        li[k] = batch_pick(moved, (i + 1) % LEVEL_SIZE, i);
+        score[k] += scored;
+        reward[k] = scored;
+        done[k] = done[k] | dead;
+        refresh[k] = renew;
+        steps[k] += live;
+        any_refresh |= renew;
+    }
+
+    //refresh_pipe(i) gives the pipe PLAYER_OFFSET columns back a new bottom, once per pipe
+    if (any_refresh){
+        for (int k = 0; k < n; k++){
+            if (env->refresh[k]){
+                int s = (env->frame[k] - PLAYER_OFFSET) / PIPE_SPACING;
+                env->has_pipe[s][k] = 1;
+                env->bottom[s][k] = rng_next_from(&env->rng[k]) % (GAP_MAX - GAP_MIN + 1) + GAP_MIN;
+            }
+        }
+    }
+}
+
+//features of lane k's next pipe: the first slot whose centre has not yet passed the bird's frame
+void batch_observe(const struct batch_env *env, float *obs){
+    const int n = env->n;
+    const int32_t *bottom[BATCH_SLOTS];
+    const int32_t *has_pipe[BATCH_SLOTS];
+    for (int s = 0; s < BATCH_SLOTS; s++){
+        bottom[s] = env->bottom[s].data();
+        has_pipe[s] = env->has_pipe[s].data();
+    }
+    const int32_t *frame = env->frame.data();
+    const int32_t *height = env->height.data();
+    const int32_t *last_dh = env->last_dh.data();
+    const int32_t *mode = env->mode.data();
+    const int32_t *cnt = env->cnt.data();
+
+    #pragma GCC ivdep
+    for (int k = 0; k < n; k++){
+        int32_t best = LEVEL_SIZE, b = -1;
+        #pragma GCC unroll 16
+        for (int s = 0; s < BATCH_SLOTS; s++){
+            int32_t d = (s * PIPE_SPACING - frame[k] + LEVEL_SIZE + PLAYER_SIZE/2) % LEVEL_SIZE - PLAYER_SIZE/2;
+            int32_t bs = bottom[s][k];
+            int32_t take = -(has_pipe[s][k] & (d < best));
+            best = batch_pick(take, d, best);
+            b = batch_pick(take, bs, b);
+        }
+        obs[BATCH_OBS_HEIGHT * n + k] = height[k];
+        obs[BATCH_OBS_VELOCITY * n + k] = last_dh[k];
+        obs[BATCH_OBS_DISTANCE * n + k] = best;
+        obs[BATCH_OBS_BOTTOM * n + k] = b;
+        obs[BATCH_OBS_TOP * n + k] = b + GAP;
+        obs[BATCH_OBS_HANG * n + k] = (JUMP_HANGTIME - cnt[k]) * (mode[k] == BATCH_JUMPING);
+    }
+}
+
+#endif /* HOST_BATCH_ENV_H */
@@ -0,0 +1,315 @@
+#ifndef HOST_HW_H
+#define HOST_HW_H
+
+//HOST PERIPHERALS
+//stand-ins for the ATmega register set so the drivers in include/ build natively unchanged
+//plain registers are variables, the ones with side effects (SPDR, EECR, UDR0) are small
+//proxies that forward to an emulated ST7735, EEPROM and UART
+//
+//the register layout follows the ATmega328P, pins match spiAVR.h (CS = PB2, DC = PB1)
+//every register and peripheral is per thread, like the GAME_LOCAL state of the core
+
+#define GAME_LOCAL thread_local
+
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//BIT NUMBERS
+enum {
+    PORTB0, PORTB1, PORTB2, PORTB3, PORTB4, PORTB5, PORTB6, PORTB7
+};
+enum {
+    PB0, PB1, PB2, PB3, PB4, PB5, PB6, PB7
+};
+enum {
+    PORTD0, PORTD1, PORTD2, PORTD3, PORTD4, PORTD5, PORTD6, PORTD7
+};
+enum {
+    SPR0 = 0, SPR1 = 1, CPHA = 2, CPOL = 3, MSTR = 4, DORD = 5, SPE = 6, SPIE = 7, //SPCR
+    SPI2X = 0, WCOL = 6, SPIF = 7,                                                  //SPSR
+    EERE = 0, EEPE = 1, EEMPE = 2, EERIE = 3,                                        //EECR
+    MPCM0 = 0, U2X0 = 1, UPE0 = 2, DOR0 = 3, FE0 = 4, UDRE0 = 5, TXC0 = 6, RXC0 = 7, //UCSR0A
+    TXB80 = 0, RXB80 = 1, UCSZ02 = 2, TXEN0 = 3, RXEN0 = 4, UDRIE0 = 5, TXCIE0 = 6, RXCIE0 = 7,
+    UCPOL0 = 0, UCSZ00 = 1, UCSZ01 = 2, USBS0 = 3, UPM00 = 4, UPM01 = 5, UMSEL00 = 6, UMSEL01 = 7,
+    UCPHA0 = 1, UDORD0 = 2,                                                          //UCSR0C in master SPI mode
+    WGM00 = 0, WGM01 = 1, COM0B0 = 4, COM0B1 = 5, COM0A0 = 6, COM0A1 = 7,            //TCCR0A
+    CS00 = 0, CS01 = 1, CS02 = 2, WGM02 = 3,                                         //TCCR0B
+    TOIE0 = 0, OCIE0A = 1, OCIE0B = 2, TOV0 = 0, OCF0A = 1, OCF0B = 2,               //TIMSK0/TIFR0
+    WGM10 = 0, WGM11 = 1, COM1B0 = 4, COM1B1 = 5, COM1A0 = 6, COM1A1 = 7,            //TCCR1A
+    CS10 = 0, CS11 = 1, CS12 = 2, WGM12 = 3, WGM13 = 4,                              //TCCR1B
+    TOIE1 = 0, OCIE1A = 1, OCIE1B = 2, TOV1 = 0, OCF1A = 1, OCF1B = 2,               //TIMSK1/TIFR1
+    TOIE2 = 0, OCIE2A = 1, OCIE2B = 2,                                               //TIMSK2
+    PORF = 0, EXTRF = 1, BORF = 2, WDRF = 3                                          //MCUSR
+};
+
+#define RAMSTART 0x100
+#define RAMEND 0x8FF
+
+#define HOST_TFT_SIZE 132
+#define HOST_EEPROM_SIZE 1024
+
+//EMULATED ST7735
+//decodes the byte stream the way the panel does: commands latch on DC low,
+//CASET/RASET take four parameter bytes, RAMWR streams pixels into the window in the COLMOD
+//format, RGB565 or RGB444 (0x03). the framebuffer holds RGB565, RGB444 is widened into it
+struct host_tft_state {
+    uint16_t fb[HOST_TFT_SIZE][HOST_TFT_SIZE];
+    uint8_t cmd;
+    uint8_t param[4];
+    uint8_t nparam;
+    uint8_t xs, xe, ys, ye;
+    uint8_t x, y;
+    uint8_t pixel_bytes[2]; //bytes of the pixel (pair) being assembled
+    uint8_t pixel_phase;    //bytes of it seen so far, 2 per pixel in RGB565, 3 per pair in RGB444
+    bool inverted;
+    uint8_t colmod;
+    uint8_t madctl;
+
+    //counters, reset with host_tft_clear_counters
+    unsigned long bytes;
+    unsigned long command_bytes;
+    unsigned long pixels;
+};
+
+inline thread_local host_tft_state host_tft;
+inline thread_local bool host_render = true; //false drops pixel bytes after counting them, TickDraw skips drawing
+inline thread_local unsigned long long host_bus_us = 0;       //time the panel bus took, see CLOCK_NOW in helper.h
+inline thread_local unsigned int host_bus_us_per_byte = 2;    //hardware SPI at fosc/4, a stress run slows it down
+
+inline void host_tft_clear_counters(){
+    host_tft.bytes = 0;
+    host_tft.command_bytes = 0;
+    host_tft.pixels = 0;
+}
+
+inline void host_tft_pixel(uint16_t color){
+    host_tft.pixels++;
+    if (host_tft.x < HOST_TFT_SIZE && host_tft.y < HOST_TFT_SIZE){
+        host_tft.fb[host_tft.y][host_tft.x] = color;
+    }
+    if (host_tft.x++ == host_tft.xe){
+        host_tft.x = host_tft.xs;
+        host_tft.y = (host_tft.y == host_tft.ye) ? host_tft.ys : host_tft.y + 1;
+    }
+}
+
+//counts a pixel, stores it when rendering
+inline void host_tft_emit(uint16_t color){
+    if (host_render){
+        host_tft_pixel(color);
+    }
+    else {
+        host_tft.pixels++;
+    }
+}
+
+//RGB444 to RGB565, each channel's top bits repeated into the new low bits
+inline uint16_t host_tft_565(uint16_t c){
+    uint16_t r = (c >> 8) & 0xF, g = (c >> 4) & 0xF, b = c & 0xF;
+    return ((r << 1 | r >> 3) << 11) | ((g << 2 | g >> 2) << 5) | (b << 1 | b >> 3);
+}
+
+inline void host_tft_byte(uint8_t data, uint8_t portb){
+    if (portb & (1 << PORTB2)){
+        return; //CS high, panel is not listening
+    }
+    host_tft.bytes++;
+    host_bus_us += host_bus_us_per_byte;
+
+    if (!(portb & (1 << PORTB1))){
+        host_tft.command_bytes++;
+        host_tft.cmd = data;
+        host_tft.nparam = 0;
+        host_tft.pixel_phase = 0; //a half sent pixel is dropped
+        if (data == 0x21) { host_tft.inverted = true; }
+        if (data == 0x20) { host_tft.inverted = false; }
+        if (data == 0x2C) { host_tft.x = host_tft.xs; host_tft.y = host_tft.ys; }
+        return;
+    }
+
+    switch(host_tft.cmd){
+        case(0x2A): //CASET
+        case(0x2B): //RASET
+            if (host_tft.nparam < 4){
+                host_tft.param[host_tft.nparam++] = data;
+            }
+            if (host_tft.nparam == 4){
+                uint8_t lo = host_tft.param[1], hi = host_tft.param[3];
+                if (host_tft.cmd == 0x2A) { host_tft.xs = lo; host_tft.xe = hi; }
+                else                      { host_tft.ys = lo; host_tft.ye = hi; }
+            }
+            break;
+
+        case(0x2C): //RAMWR
+            if (host_tft.colmod == 0x03){
+                //R1G1 B1R2 G2B2
+                uint8_t *p = host_tft.pixel_bytes;
+                if (host_tft.pixel_phase == 1){
+                    host_tft_emit(host_tft_565((p[0] << 4) | (data >> 4)));
+                }
+                else if (host_tft.pixel_phase == 2){
+                    host_tft_emit(host_tft_565(((p[1] & 0x0F) << 8) | data));
+                    host_tft.pixel_phase = 0;
+                    break;
+                }
+                p[host_tft.pixel_phase++] = data;
+            }
+            else if (host_tft.pixel_phase == 0){
+                host_tft.pixel_bytes[0] = data;
+                host_tft.pixel_phase = 1;
+            }
+            else {
+                host_tft.pixel_phase = 0;
+                host_tft_emit((host_tft.pixel_bytes[0] << 8) | data);
+            }
+            break;
+
+        case(0x3A): host_tft.colmod = data; break;
+        case(0x36): host_tft.madctl = data; break;
+        default: break;
+    }
+}
+
+//EMULATED EEPROM, stored inverted so zero initialised memory reads back erased (0xFF)
+inline thread_local uint8_t host_eeprom_inv[HOST_EEPROM_SIZE];
+inline thread_local unsigned long host_eeprom_writes = 0;
+inline thread_local unsigned long host_eeprom_lost = 0; //writes an interrupt broke, see host_eecr_reg
+
+inline uint8_t host_eeprom_get(unsigned int addr){
+    return host_eeprom_inv[addr % HOST_EEPROM_SIZE] ^ 0xFF;
+}
+
+inline void host_eeprom_set(unsigned int addr, uint8_t data){
+    host_eeprom_inv[addr % HOST_EEPROM_SIZE] = data ^ 0xFF;
+    host_eeprom_writes++;
+}
+
+//EMULATED UART, TX is captured, a runner sets host_uart_rx and calls the RX ISR to receive
+#define HOST_UART_OUT_SIZE 4096
+inline thread_local char host_uart_out[HOST_UART_OUT_SIZE];
+inline thread_local unsigned int host_uart_out_len = 0;
+inline thread_local bool host_uart_echo = false; //copy TX to stdout
+inline thread_local uint8_t host_uart_rx = 0;
+
+//SIMULATED TIME, advanced by _delay_ms/_delay_us and by the runner per scheduler cycle
+inline thread_local unsigned long long host_time_us = 0;
+//time the board would spend waiting on UART bytes and EEPROM writes, the drivers' polled waits
+//return at once here. kept out of CLOCK_NOW so the game runs the same, only the watchdog model in
+//avr/wdt.h reads it. every EEPROM write is charged, the snapshot's background ones too
+inline thread_local unsigned long long host_wait_us = 0;
+#define HOST_EEPROM_WRITE_US 3400 //tWD_EEPROM, 3.3 ms a byte
+
+//PROXY REGISTERS
+struct host_spdr_reg {
+    uint8_t value;
+    host_spdr_reg& operator=(uint8_t data);
+    operator uint8_t() const { return value; }
+};
+
+struct host_eecr_reg {
+    uint8_t value;
+    host_eecr_reg& operator=(uint8_t v) { value = v; return *this; }
+    host_eecr_reg& operator|=(uint8_t bits);
+    host_eecr_reg& operator&=(uint8_t bits) { value &= bits; return *this; }
+    operator uint8_t() const { return value & ~(1 << EEPE); } //writes finish instantly
+};
+
+struct host_ucsr0a_reg {
+    uint8_t value;
+    host_ucsr0a_reg& operator=(uint8_t v) { value = v & ((1 << U2X0) | (1 << MPCM0)); return *this; }
+    operator uint8_t() const { return value | (1 << UDRE0) | (1 << TXC0); } //bytes go out instantly
+};
+
+struct host_udr_reg {
+    host_udr_reg& operator=(uint8_t data);
+    operator uint8_t() const { return host_uart_rx; }
+};
+
+
+//PLAIN REGISTERS
+inline thread_local volatile uint8_t PORTB, PORTC, PORTD, DDRB, DDRC, DDRD, PINB, PINC, PIND;
+inline thread_local volatile uint8_t SPCR;
+inline thread_local volatile uint8_t SPSR = (1 << SPIF); //transfers complete instantly
+inline thread_local host_spdr_reg SPDR;
+inline thread_local host_eecr_reg EECR;
+inline thread_local volatile uint8_t EEDR;
+inline thread_local volatile uint16_t EEAR;
+inline thread_local host_ucsr0a_reg UCSR0A;
+inline thread_local volatile uint8_t UCSR0B, UCSR0C;
+inline thread_local volatile uint16_t UBRR0;
+inline thread_local host_udr_reg UDR0;
+inline thread_local volatile uint8_t TCCR0A, TCCR0B, OCR0A, OCR0B, TCNT0, TIMSK0, TIFR0;
+inline thread_local volatile uint8_t TCCR1A, TCCR1B, TIMSK1, TIFR1;
+inline thread_local volatile uint16_t ICR1, OCR1A, OCR1B, TCNT1;
+inline thread_local volatile uint8_t TCCR2A, TCCR2B, OCR2A, TIMSK2, TCNT2;
+inline thread_local volatile uint8_t SREG, MCUSR;
+inline thread_local volatile uint16_t SP = RAMEND;
+
+inline host_spdr_reg& host_spdr_reg::operator=(uint8_t data){
+    value = data;
+    host_tft_byte(data, PORTB);
+    return *this;
+}
+
+//the UART's TX, or the TFT's byte stream while UCSR0C has the USART in master SPI mode
+inline host_udr_reg& host_udr_reg::operator=(uint8_t data){
+    if ((UCSR0C & ((1 << UMSEL01) | (1 << UMSEL00))) == ((1 << UMSEL01) | (1 << UMSEL00))){
+        host_tft_byte(data, PORTB);
+        return *this;
+    }
+    host_wait_us += 10UL * (UBRR0 + 1); //start, 8 data and stop bits at 16 MHz
+    if (host_uart_out_len < HOST_UART_OUT_SIZE - 1){
+        host_uart_out[host_uart_out_len++] = data;
+        host_uart_out[host_uart_out_len] = '\0';
+    }
+    if (host_uart_echo){
+        putchar(data);
+    }
+    return *this;
+}
+
+inline host_eecr_reg& host_eecr_reg::operator|=(uint8_t bits){
+    if (bits & (1 << EERE)){
+        EEDR = host_eeprom_get(EEAR);
+    }
+    //the sound ISR can nest while the global flag is on and Timer0 is running, the model lets it in
+    //after EEMPE every time: the 4 cycle window passes and the EEPE below writes nothing
+    if ((bits & (1 << EEMPE)) && (SREG & 0x80) && (TIMSK0 & (1 << OCIE0A))){
+        bits &= ~(1 << EEMPE);
+        host_eeprom_lost++;
+    }
+    if ((bits & (1 << EEPE)) && (value & (1 << EEMPE))){
+        host_eeprom_set(EEAR, EEDR);
+        host_wait_us += HOST_EEPROM_WRITE_US;
+        bits &= ~((1 << EEPE) | (1 << EEMPE));
+        value &= ~(1 << EEMPE);
+    }
+    value |= bits & ~(1 << EERE);
+    return *this;
+}
+
+//avr-libc extra the drivers rely on
+inline char* itoa(int value, char *buf, int radix){
+    if (radix == 10){
+        sprintf(buf, "%d", value);
+    }
+    else {
+        char tmp[sizeof(int) * 8 + 1];
+        unsigned int v = (unsigned int)value;
+        int n = 0;
+        do {
+            int d = v % radix;
+            tmp[n++] = d < 10 ? '0' + d : 'a' + d - 10;
+            v /= radix;
+        } while (v);
+        for (int i = 0; i < n; i++){
+            buf[i] = tmp[n - 1 - i];
+        }
+        buf[n] = '\0';
+    }
+    return buf;
+}
+
+#endif /* HOST_HW_H */
@@ -0,0 +1,140 @@
+#ifndef HOST_SIM_H
+#define HOST_SIM_H
+
+//HOST RUNNER
+//boots the game core without a panel, steps the scheduler one cycle at a time and plays
+//with a simple autopilot, shared by the native tools in src/
+
+#include "game.h"
+
+struct sim_run {
+    unsigned long start_tick; //tick the run left the paused screen
+    unsigned long death_tick; //0 if the run was still alive after max_ticks
+    int score;
+    int height;
+};
+
+GAME_LOCAL unsigned long sim_last_menu = PAUSED;
+GAME_LOCAL int sim_last_score = 0;
+GAME_LOCAL unsigned long sim_tick_bytes_max = 0; //most panel bytes any one cycle sent, the longest ISR
+
+//mirror of main() minus the panel and LCD bring-up delays
+//the timerISR.h countdown is never used, sim_tick calls TimerISR directly
+void sim_boot(unsigned long seed){
+    rng_seed(seed);
+    SPI_INIT();
+    ST7735_config(); //color mode, the emulated panel decodes pixels by it
+    serial_init(9600);
+    remote_init();
+    tasks_init();
+    create_level();
+    scoreboard_init();
+}
+
+//one scheduler cycle, the same work TIMER2_COMPA_vect triggers every GCD_PERIOD on the board
+void sim_tick(){
+    sim_last_menu = tasks[3].state;
+    sim_last_score = score;
+    unsigned long bytes = host_tft.bytes;
+    TimerISR();
+    if (host_tft.bytes - bytes > sim_tick_bytes_max){
+        sim_tick_bytes_max = host_tft.bytes - bytes;
+    }
+    //EEPROM writes finish instantly here, so a background snapshot write completes before the next cycle
+    while (EECR & (1 << EERIE)){
+        EE_READY_vect();
+    }
+    host_time_us += GCD_PERIOD * 1000UL;
+}
+
+//one remote.h command line through the RX interrupt, the next sim_tick runs it
+void sim_send(const char *line){
+    for (const char *c = line; ; c++){
+        host_uart_rx = (*c != '\0') ? *c : '\n';
+        USART_RX_vect();
+        if (*c == '\0'){
+            break;
+        }
+    }
+}
+
+void sim_buttons(bool control, bool jump){
+    PINC = (control ? 0x01 : 0x00) | (jump ? 0x02 : 0x00);
+}
+
+bool sim_died(){
+    return sim_last_menu == PLAYING && tasks[3].state == RESETTING;
+}
+
+//seeds the level generator and resets through the same path as the remote 's' command
+void sim_reset(unsigned long seed){
+    remote_seed = seed;
+    remote_seeded = true;
+    remote_reset = true;
+    sim_buttons(false, false);
+    sim_tick();
+    sim_tick(); //TickDraw SETUP regenerates the level
+}
+
+//tap control to leave the paused screen
+void sim_start(){
+    sim_buttons(false, false);
+    while (tasks[3].state != PAUSED){
+        sim_tick(); //a reset passes through HOLDING_PAUSED first
+    }
+    sim_buttons(true, false);
+    sim_tick();
+    sim_buttons(false, false);
+    sim_tick();
+}
+
+//next pipe at or ahead of the bird, -1 if none within a pipe spacing
+int sim_next_pipe(){
+    for (int k = -PLAYER_SIZE/2; k < PIPE_SPACING; k++){
+        int i = (frame + k + LEVEL_SIZE) % LEVEL_SIZE;
+        if (columns[i].has_pipe){
+            return i;
+        }
+    }
+    return -1;
+}
+
+//autopilot: tap jump whenever the bird sits below the middle of the next gap
+//a tap is one tick down, one tick up, the same as TickButtons sees from a finger
+bool sim_autopilot(){
+    static GAME_LOCAL bool pressed = false;
+    int pipe = sim_next_pipe();
+    int target = (pipe < 0) ? 64 : columns[pipe].bottom + columns[pipe].gap / 2;
+    pressed = !pressed && height < target;
+    return pressed;
+}
+
+//plays one run from the paused screen to the death tick, gives up after max_ticks
+//policy returns the jump level for the coming tick
+struct sim_run sim_play(unsigned long max_ticks, bool (*policy)() = sim_autopilot){
+    struct sim_run run;
+    sim_start();
+    run.start_tick = tick_count;
+    run.death_tick = 0;
+    run.score = 0;
+    run.height = 0;
+
+    while (tick_count - run.start_tick < max_ticks){
+        sim_buttons(false, policy());
+        sim_tick();
+        if (sim_died()){
+            run.death_tick = tick_count;
+            run.score = sim_last_score;
+            run.height = height;
+            break;
+        }
+    }
+    if (!run.death_tick){
+        run.score = score;
+        run.height = height;
+    }
+    sim_buttons(false, false);
+    return run;
+}
+
+#endif /* HOST_SIM_H */
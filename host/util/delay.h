@@ -0,0 +1,15 @@
+#ifndef HOST_UTIL_DELAY_H
+#define HOST_UTIL_DELAY_H
+
+//native build stand-in for <util/delay.h>, busy waits only advance simulated time
+#include "../host_hw.h"
+
+inline void _delay_ms(double ms){
+    host_time_us += (unsigned long long)(ms * 1000);
+}
+
+inline void _delay_us(double us){
+    host_time_us += (unsigned long long)us;
+}
+
+#endif /* HOST_UTIL_DELAY_H */
@@ -0,0 +1,107 @@
+#ifndef HOST_WORK_POOL_H
+#define HOST_WORK_POOL_H
+
+//WORK-STEALING POOL
+//splits [0, count) into chunks of grain indices, each worker starts with a contiguous share
+//in its own deque, pops from the back of it and steals from the front of the others when dry
+//chunks never split, so every index runs exactly once on exactly one thread
+//
+//the game core is GAME_LOCAL (thread_local on host), a worker's init callback boots its own copy
+
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+struct work_chunk {
+    unsigned long first;
+    unsigned long last; //exclusive
+};
+
+struct work_queue {
+    std::mutex lock;
+    std::deque<struct work_chunk> chunks;
+};
+
+struct work_stats {
+    unsigned long chunks_run;
+    unsigned long chunks_stolen;
+};
+
+//owner end, newest chunk first so a worker walks its share in order from the back
+bool work_pop(struct work_queue *q, struct work_chunk *out){
+    std::lock_guard<std::mutex> guard(q->lock);
+    if (q->chunks.empty()){
+        return false;
+    }
+    *out = q->chunks.back();
+    q->chunks.pop_back();
+    return true;
+}
+
+//thief end, oldest chunk first so the thief and the owner work apart
+bool work_steal(struct work_queue *q, struct work_chunk *out){
+    std::lock_guard<std::mutex> guard(q->lock);
+    if (q->chunks.empty()){
+        return false;
+    }
+    *out = q->chunks.front();
+    q->chunks.pop_front();
+    return true;
+}
+
+//runs job(index) for every index on threads workers, returns per worker counts
+//init(worker) runs once on each worker thread before its first job
+std::vector<struct work_stats> work_run(unsigned long count, unsigned long grain, unsigned int threads,
+                                        std::function<void(unsigned int)> init,
+                                        std::function<void(unsigned long)> job){
+    if (threads == 0){
+        threads = 1;
+    }
+    if (grain == 0){
+        grain = 1;
+    }
+
+    std::vector<struct work_queue> queues(threads);
+    unsigned long nchunks = (count + grain - 1) / grain;
+    for (unsigned long c = 0; c < nchunks; c++){
+        struct work_chunk chunk = {c * grain, (c + 1) * grain < count ? (c + 1) * grain : count};
+        //contiguous shares, pushed in reverse so the owner pops them in index order
+        unsigned int owner = (unsigned int)(c * threads / nchunks);
+        queues[owner].chunks.push_front(chunk);
+    }
+
+    std::vector<struct work_stats> stats(threads, work_stats{0, 0});
+    auto worker = [&](unsigned int self){
+        init(self);
+        struct work_chunk chunk;
+        while (true){
+            bool stolen = false;
+            bool found = work_pop(&queues[self], &chunk);
+            for (unsigned int k = 1; !found && k < threads; k++){
+                found = stolen = work_steal(&queues[(self + k) % threads], &chunk);
+            }
+            if (!found){
+                break; //chunks are only ever removed, every deque is empty
+            }
+            for (unsigned long i = chunk.first; i < chunk.last; i++){
+                job(i);
+            }
+            stats[self].chunks_run++;
+            stats[self].chunks_stolen += stolen;
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int t = 1; t < threads; t++){
+        pool.emplace_back(worker, t);
+    }
+    worker(0); //the calling thread is worker 0
+    for (auto &t : pool){
+        t.join();
+    }
+    return stats;
+}
+
+#endif /* HOST_WORK_POOL_H */
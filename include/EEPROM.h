@@ -3,6 +3,7 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <util/delay.h>
+#include <avr/wdt.h>
 #define EEPROM_SCORE_ADDR 0x3FF  // last byte of EEPROM
 
 
@@ -10,13 +11,19 @@
 void EEPROM_write_score(unsigned int uiAddress, unsigned char ucData){
     /* Wait for completion of previous write */
     while(EECR & (1<<EEPE));
+    /* The last write finished, a long block ('e') kicks the watchdog once a byte */
+    wdt_reset();
     /* Set up address and Data Registers */
     EEAR = uiAddress;
     EEDR = ucData;
+    /* EEPE has to follow EEMPE within 4 cycles, the tasks run with the sound ISR able to nest */
+    uint8_t sreg = SREG;
+    cli();
     /* Write logical one to EEMPE */
     EECR |= (1<<EEMPE);
     /* Start eeprom write by setting EEPE */
     EECR |= (1<<EEPE);
+    SREG = sreg;
 }
 
 unsigned char EEPROM_read(unsigned int uiAddress){
@@ -30,4 +37,16 @@ unsigned char EEPROM_read(unsigned int uiAddress){
     /* Return data from Data Register */
     return EEDR;
 }
+
+void EEPROM_write_block(unsigned int uiAddress, const unsigned char *data, unsigned int len){
+    for (unsigned int i = 0; i < len; i++){
+        EEPROM_write_score(uiAddress + i, data[i]);
+    }
+}
+
+void EEPROM_read_block(unsigned int uiAddress, unsigned char *data, unsigned int len){
+    for (unsigned int i = 0; i < len; i++){
+        data[i] = EEPROM_read(uiAddress + i);
+    }
+}
 #endif 
\ No newline at end of file
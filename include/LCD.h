@@ -2,7 +2,9 @@
 #define LCD_H_
 
 #include <avr/io.h>
+#include <avr/pgmspace.h>
 #include <util/delay.h>
+#include "eventTrace.h"
 
 #define DATA_BUS	PORTD
 #define CTL_BUS		PORTD
@@ -30,6 +32,7 @@
 
 void lcd_send_command (uint8_t command)
 {
+	TRACE_BEGIN(TRACE_LCD);
 	DATA_BUS=(command&0b11110000); 
 	CTL_BUS &=~(1<<LCD_RS);
 	CTL_BUS |=(1<<LCD_EN);
@@ -41,6 +44,7 @@ void lcd_send_command (uint8_t command)
 	_delay_ms(1);
 	CTL_BUS &=~(1<<LCD_EN);
 	_delay_ms(1);
+	TRACE_END(TRACE_LCD);
 }
 
 void lcd_init(void)
@@ -66,9 +70,30 @@ void lcd_init(void)
 }
 
 
+//NON-BLOCKING WRITES, only the enable pulse is timed here
+//the caller spaces them out: 37 us per command or character, 1.52 ms after clear/home
+void lcd_pulse_nibble(uint8_t nibble, uint8_t rs)
+{
+	DATA_BUS = (DATA_BUS & 0x0F) | (nibble & 0b11110000);
+	if (rs) { CTL_BUS |= (1<<LCD_RS); }
+	else    { CTL_BUS &= ~(1<<LCD_RS); }
+	CTL_BUS |= (1<<LCD_EN);
+	_delay_us(1);
+	CTL_BUS &= ~(1<<LCD_EN);
+	_delay_us(1);
+}
+
+void lcd_send_fast(uint8_t data, uint8_t rs)
+{
+	TRACE_BEGIN(TRACE_LCD);
+	lcd_pulse_nibble(data, rs);
+	lcd_pulse_nibble(data << 4, rs);
+	TRACE_END(TRACE_LCD);
+}
+
 void lcd_write_character(char character)
 {
-	
+	TRACE_BEGIN(TRACE_LCD);
 	DATA_BUS=(DATA_BUS & 0x0F) | (character & 0b11110000);
 	CTL_BUS|=(1<<LCD_RS);
 	CTL_BUS |=(1<<LCD_EN);
@@ -80,7 +105,7 @@ void lcd_write_character(char character)
 	_delay_ms(2);
 	CTL_BUS &=~(1<<LCD_EN);
 	_delay_ms(2);
-	
+	TRACE_END(TRACE_LCD);
 }
 
 void lcd_write_str(char* str)
@@ -93,6 +118,16 @@ void lcd_write_str(char* str)
 	}
 }
 
+//a string from flash, PSTR("...") or a PROGMEM array, the fixed labels stay out of SRAM
+void lcd_write_P(const char *str)
+{
+	char ch;
+	while ((ch = pgm_read_byte(str++)) != '\0')
+	{
+		lcd_write_character(ch);
+	}
+}
+
 void lcd_clear()
 {
 	lcd_send_command(LCD_CMD_CLEAR_DISPLAY);
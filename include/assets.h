@@ -0,0 +1,190 @@
+//GENERATED by scripts/asset_compiler.py from assets/*.png, do not edit
+//run length images for rleImage.h, DrawImage(asset_<name>, x, y)
+//
+//image          pixels  raw bytes  rle bytes   ratio
+//background      17424      34848        863   40.4x
+//gameover         3712       7424        851    8.7x
+//splash           5000      10000        771   13.0x
+
+#ifndef ASSETS_H
+#define ASSETS_H
+
+#include <stdint.h>
+#include <avr/pgmspace.h>
+
+#define ASSET_BACKGROUND_W 132
+#define ASSET_BACKGROUND_H 132
+#define ASSET_BACKGROUND_FNV 0x1EED8E8262CCCAADULL //FNV-1a of the RGB565 pixels in stream order
+const uint8_t asset_background[] PROGMEM = {
+    0x84, 0x84, 0x09, 0x72, 0xF6, 0xCD, 0xED, 0xAF, 0xBC, 0x37, 0xFF, 0xAB, 0x45, 0x5B, 0x86, 0xFF,
+    0xFF, 0x67, 0x34, 0x3D, 0xAF, 0x5F, 0xFF, 0x5F, 0xFF, 0x5F, 0xFF, 0x5F, 0xFF, 0x5F, 0xDC, 0x7F,
+    0xF8, 0x4F, 0xFF, 0x4F, 0xFF, 0x4F, 0xFF, 0x4F, 0x67, 0x72, 0x4F, 0x6F, 0x77, 0x4F, 0x20, 0x74,
+    0x4F, 0x35, 0x73, 0x22, 0x74, 0x4F, 0x1C, 0x79, 0x4F, 0x1E, 0x76, 0x4B, 0x72, 0x21, 0x81, 0x23,
+    0x73, 0x4F, 0x18, 0x73, 0x24, 0x75, 0x4F, 0x19, 0x7D, 0x42, 0x70, 0x41, 0x71, 0x29, 0x31, 0x74,
+    0x4F, 0x14, 0x72, 0x29, 0x7F, 0x02, 0x4F, 0x08, 0x73, 0x81, 0x21, 0x81, 0x20, 0x7B, 0x2A, 0x31,
+    0x21, 0x7E, 0x4F, 0x07, 0x71, 0x20, 0x81, 0x21, 0x81, 0x21, 0x81, 0x23, 0x7F, 0x01, 0x4F, 0x05,
+    0x72, 0x2D, 0x72, 0x30, 0x71, 0x2B, 0x31, 0x24, 0x7E, 0x4F, 0x03, 0x71, 0x2F, 0x00, 0x32, 0x27,
+    0x31, 0x21, 0x72, 0x4F, 0x03, 0x71, 0x31, 0x2E, 0x34, 0x2B, 0x31, 0x28, 0x31, 0x25, 0x74, 0x4F,
+    0x00, 0x71, 0x30, 0x2F, 0x00, 0x32, 0x27, 0x31, 0x23, 0x72, 0x4F, 0x00, 0x71, 0x20, 0x31, 0x2E,
+    0x34, 0x21, 0x81, 0x21, 0x81, 0x23, 0x31, 0x28, 0x31, 0x28, 0x72, 0x4C, 0x72, 0x31, 0x2F, 0x00,
+    0x32, 0x21, 0x81, 0x23, 0x31, 0x24, 0x72, 0x4D, 0x71, 0x21, 0x31, 0x2E, 0x34, 0x2B, 0x31, 0x28,
+    0x31, 0x21, 0x81, 0x21, 0x81, 0x21, 0x80, 0x72, 0x49, 0x72, 0x32, 0x2F, 0x00, 0x32, 0x27, 0x31,
+    0x26, 0x72, 0x49, 0x72, 0x22, 0x31, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x22, 0x34, 0x2B, 0x31,
+    0x21, 0x81, 0x21, 0x81, 0x20, 0x31, 0x2B, 0x73, 0x45, 0x72, 0x21, 0x32, 0x21, 0x81, 0x21, 0x81,
+    0x21, 0x81, 0x23, 0x32, 0x27, 0x31, 0x27, 0x73, 0x46, 0x72, 0x23, 0x31, 0x2E, 0x34, 0x2B, 0x31,
+    0x28, 0x31, 0x2D, 0x79, 0x22, 0x32, 0x2F, 0x00, 0x32, 0x27, 0x31, 0x21, 0x81, 0x21, 0x81, 0x21,
+    0x79, 0x25, 0x31, 0x2E, 0x34, 0x2B, 0x31, 0x28, 0x31, 0x2D, 0x31, 0x75, 0x24, 0x32, 0x2F, 0x00,
+    0x32, 0x27, 0x31, 0x2B, 0x76, 0x21, 0x81, 0x22, 0x31, 0x2E, 0x34, 0x21, 0x81, 0x21, 0x81, 0x23,
+    0x31, 0x28, 0x31, 0x2D, 0x32, 0x29, 0x32, 0x2F, 0x00, 0x32, 0x21, 0x81, 0x23, 0x31, 0x2C, 0x31,
+    0x2A, 0x31, 0x2E, 0x34, 0x2B, 0x31, 0x28, 0x31, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x21, 0x32,
+    0x21, 0x81, 0x21, 0x81, 0x21, 0x32, 0x2F, 0x00, 0x32, 0x27, 0x31, 0x2C, 0x31, 0x2A, 0x31, 0x21,
+    0x81, 0x21, 0x81, 0x21, 0x81, 0x22, 0x34, 0x2B, 0x31, 0x21, 0x81, 0x21, 0x81, 0x20, 0x31, 0x2D,
+    0x32, 0x29, 0x32, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x23, 0x32, 0x27, 0x31, 0x2C, 0x31, 0x2A,
+    0x31, 0x2E, 0x34, 0x2B, 0x31, 0x28, 0x31, 0x2D, 0x32, 0x29, 0x32, 0x2F, 0x00, 0x32, 0x27, 0x31,
+    0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x20, 0x31, 0x2A, 0x31, 0x2E, 0x34, 0x2B, 0x31, 0x28, 0x31,
+    0x2D, 0x32, 0x29, 0x32, 0x2F, 0x00, 0x3C, 0x2C, 0x31, 0x21, 0x81, 0x21, 0x81, 0x22, 0x31, 0x2E,
+    0x34, 0x21, 0x81, 0x21, 0x81, 0x23, 0x31, 0x28, 0x31, 0x2D, 0x32, 0x29, 0x32, 0x2F, 0x00, 0x3C,
+    0x2C, 0x31, 0x2A, 0x31, 0x2E, 0x34, 0x2B, 0x3C, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x21, 0x32,
+    0x21, 0x81, 0x21, 0x81, 0x21, 0x32, 0x2F, 0x00, 0x3C, 0x2C, 0x31, 0x2A, 0x31, 0x21, 0x81, 0x21,
+    0x81, 0x21, 0x81, 0x22, 0x34, 0x2B, 0x3C, 0x2D, 0x32, 0x29, 0x32, 0x21, 0x81, 0x21, 0x81, 0x21,
+    0x81, 0x23, 0x3C, 0x2C, 0x31, 0x2A, 0x31, 0x2E, 0x34, 0x2B, 0x3C, 0x2D, 0x32, 0x29, 0x32, 0x2F,
+    0x00, 0x3C, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x20, 0x3E, 0x2E, 0x34, 0x2B, 0x3C, 0x2D, 0x32,
+    0x29, 0x32, 0x2F, 0x00, 0x3C, 0x2C, 0x3E, 0x2E, 0x34, 0x21, 0x81, 0x21, 0x81, 0x23, 0x3C, 0x2D,
+    0x3F, 0x00, 0x2F, 0x00, 0x3C, 0x2C, 0x3E, 0x2E, 0x34, 0x2B, 0x3C, 0x21, 0x81, 0x21, 0x81, 0x21,
+    0x81, 0x21, 0x3F, 0x00, 0x2F, 0x00, 0x3C, 0x2C, 0x3E, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x22,
+    0x34, 0x2B, 0x3C, 0x2D, 0x3F, 0x00, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x23, 0x3C, 0x2C, 0x3E,
+    0x2E, 0x34, 0x2B, 0x3C, 0x2D, 0x3F, 0x00, 0x2F, 0x00, 0x3C, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81,
+    0x20, 0x3E, 0x2E, 0x3F, 0x0E, 0x2D, 0x3F, 0x00, 0x2F, 0x00, 0x3C, 0x2C, 0x3E, 0x2E, 0x3F, 0x0E,
+    0x2D, 0x3F, 0x00, 0x2F, 0x00, 0x3C, 0x2C, 0x3F, 0x2C, 0x21, 0x81, 0x21, 0x81, 0x21, 0x81, 0x21,
+    0x3F, 0x1D, 0x2C, 0x3F, 0x2C, 0x2D, 0x3F, 0x1D, 0x2C, 0x3F, 0x2C, 0x2D, 0x3F, 0x1D, 0x21, 0x81,
+    0x21, 0x81, 0x21, 0x81, 0x20, 0x3F, 0x2C, 0x2D, 0x3F, 0x1D, 0x2C, 0x3F, 0x67, 0x2C, 0x3F, 0x67,
+    0x2C, 0x3F, 0xFF, 0x3F, 0x8E, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0x10, 0x60,
+    0x0F, 0x6C, 0x6E, 0x0F, 0x63, 0x6F, 0x03, 0x0F, 0x60, 0x6F, 0x05, 0x0F, 0x5E, 0x6F, 0x07, 0x0F,
+    0x5E, 0x6F, 0x05, 0x0F, 0x60, 0x6F, 0x03, 0x0F, 0x63, 0x6E, 0x0F, 0x6C, 0x60, 0x0F, 0xFF, 0x0F,
+    0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0xFF, 0x0F, 0x69, 0x60, 0x0F, 0x6A, 0x6F, 0x03,
+    0x0F, 0x5E, 0x6F, 0x09, 0x0F, 0x59, 0x6F, 0x0D, 0x0F, 0x56, 0x6F, 0x0F, 0x0F, 0x54, 0x6F, 0x12,
+    0x0F, 0x53, 0x6F, 0x13, 0x0F, 0x52, 0x6F, 0x13, 0x0F, 0x53, 0x6F, 0x11, 0x0F, 0x56, 0x6F, 0x0F,
+    0x0F, 0x5E, 0x60, 0x02, 0x6F, 0x01, 0x0F, 0x03, 0x1F, 0x50, 0x6F, 0x01, 0x1F, 0x64, 0x6E, 0x1F,
+    0x67, 0x6A, 0x1F, 0x6E, 0x60, 0x1F, 0xFF, 0x1F, 0xA0, 0x60, 0x1F, 0x6B, 0x6F, 0x01, 0x1F, 0x60,
+    0x6F, 0x07, 0x1F, 0x5C, 0x6F, 0x09, 0x1F, 0x5A, 0x6F, 0x0B, 0x1F, 0x58, 0x6F, 0x0E, 0x1F, 0x57,
+    0x6F, 0x0F, 0x1F, 0x56, 0x6F, 0x0F, 0x1F, 0x56, 0x6F, 0x0E, 0x1F, 0x59, 0x6F, 0x0C, 0x1F, 0x60,
+    0x60, 0x10, 0x6F, 0x01, 0x1F, 0x63, 0x6F, 0x01, 0x1F, 0x64, 0x6E, 0x1F, 0x67, 0x6A, 0x1F, 0x6E,
+    0x60, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xFF, 0x1F, 0xAB,
+};
+
+#define ASSET_GAMEOVER_W 116
+#define ASSET_GAMEOVER_H 32
+#define ASSET_GAMEOVER_FNV 0xA63BEB1FE46A4029ULL //FNV-1a of the RGB565 pixels in stream order
+const uint8_t asset_gameover[] PROGMEM = {
+    0x74, 0x20, 0x04, 0x9F, 0xCF, 0x45, 0x41, 0x59, 0x29, 0x92, 0x1A, 0x1F, 0xDA, 0x0F, 0x04, 0x10,
+    0x02, 0x10, 0x01, 0x12, 0x01, 0x14, 0x00, 0x13, 0x09, 0x10, 0x03, 0x12, 0x07, 0x10, 0x04, 0x14,
+    0x00, 0x10, 0x02, 0x10, 0x02, 0x10, 0x0F, 0x07, 0x13, 0x0F, 0x04, 0x10, 0x02, 0x10, 0x00, 0x10,
+    0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10, 0x08, 0x10, 0x02, 0x10, 0x02, 0x10, 0x06, 0x10,
+    0x04, 0x10, 0x04, 0x10, 0x02, 0x10, 0x02, 0x10, 0x0F, 0x07, 0x13, 0x0F, 0x04, 0x10, 0x02, 0x10,
+    0x00, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10, 0x08, 0x10, 0x02, 0x10, 0x02, 0x10,
+    0x06, 0x10, 0x04, 0x10, 0x04, 0x10, 0x02, 0x10, 0x02, 0x10, 0x0F, 0x07, 0x13, 0x0F, 0x04, 0x14,
+    0x00, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10, 0x08, 0x10, 0x02, 0x10, 0x02, 0x10,
+    0x06, 0x13, 0x01, 0x10, 0x04, 0x14, 0x02, 0x10, 0x0F, 0x07, 0x13, 0x0F, 0x04, 0x10, 0x02, 0x10,
+    0x00, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10, 0x08, 0x10, 0x02, 0x10, 0x02, 0x10,
+    0x06, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10, 0x01, 0x10, 0x00, 0x10, 0x0F, 0x06,
+    0x13, 0x0F, 0x04, 0x10, 0x02, 0x10, 0x00, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10,
+    0x08, 0x10, 0x02, 0x10, 0x02, 0x10, 0x06, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10, 0x02, 0x10,
+    0x00, 0x10, 0x02, 0x10, 0x0F, 0x05, 0x13, 0x0F, 0x04, 0x10, 0x02, 0x10, 0x01, 0x12, 0x01, 0x10,
+    0x04, 0x13, 0x07, 0x14, 0x01, 0x12, 0x07, 0x13, 0x01, 0x10, 0x05, 0x12, 0x01, 0x10, 0x02, 0x10,
+    0x0F, 0x05, 0x13, 0x0F, 0x60, 0x13, 0x0F, 0x60, 0x13, 0x0F, 0x60, 0x13, 0x05, 0x37, 0x01, 0x31,
+    0x05, 0x31, 0x01, 0x31, 0x05, 0x31, 0x01, 0x39, 0x0F, 0x00, 0x35, 0x07, 0x31, 0x05, 0x39, 0x01,
+    0x31, 0x05, 0x31, 0x01, 0x13, 0x04, 0x27, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21,
+    0x30, 0x04, 0x21, 0x30, 0x00, 0x29, 0x30, 0x0E, 0x25, 0x30, 0x06, 0x21, 0x30, 0x04, 0x29, 0x30,
+    0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x01, 0x13, 0x03, 0x30, 0x27, 0x30, 0x00, 0x21, 0x30, 0x04,
+    0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x29, 0x0E, 0x30, 0x25, 0x00, 0x31, 0x03,
+    0x30, 0x21, 0x00, 0x31, 0x02, 0x29, 0x01, 0x21, 0x30, 0x03, 0x30, 0x21, 0x02, 0x13, 0x02, 0x21,
+    0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30,
+    0x00, 0x21, 0x30, 0x0F, 0x05, 0x21, 0x30, 0x04, 0x21, 0x30, 0x02, 0x21, 0x30, 0x00, 0x21, 0x30,
+    0x02, 0x21, 0x30, 0x08, 0x21, 0x30, 0x02, 0x21, 0x30, 0x03, 0x13, 0x02, 0x21, 0x30, 0x04, 0x21,
+    0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30,
+    0x0F, 0x05, 0x21, 0x30, 0x04, 0x21, 0x30, 0x01, 0x30, 0x21, 0x01, 0x21, 0x00, 0x31, 0x00, 0x21,
+    0x30, 0x08, 0x21, 0x30, 0x01, 0x30, 0x21, 0x04, 0x13, 0x02, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00,
+    0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x0F, 0x05,
+    0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x08, 0x21,
+    0x30, 0x00, 0x21, 0x30, 0x05, 0x13, 0x02, 0x21, 0x30, 0x01, 0x32, 0x21, 0x30, 0x00, 0x21, 0x35,
+    0x21, 0x30, 0x00, 0x21, 0x30, 0x01, 0x31, 0x00, 0x21, 0x30, 0x00, 0x21, 0x36, 0x0E, 0x21, 0x30,
+    0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x36, 0x02, 0x21, 0x31, 0x21,
+    0x32, 0x03, 0x13, 0x02, 0x21, 0x30, 0x00, 0x25, 0x30, 0x00, 0x29, 0x30, 0x00, 0x21, 0x30, 0x00,
+    0x21, 0x30, 0x00, 0x21, 0x30, 0x00, 0x27, 0x30, 0x0E, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21,
+    0x30, 0x04, 0x21, 0x30, 0x00, 0x27, 0x30, 0x02, 0x27, 0x30, 0x03, 0x13, 0x02, 0x21, 0x30, 0x00,
+    0x25, 0x01, 0x29, 0x30, 0x00, 0x21, 0x30, 0x00, 0x21, 0x30, 0x00, 0x21, 0x30, 0x00, 0x27, 0x0F,
+    0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x27, 0x03, 0x27,
+    0x00, 0x31, 0x01, 0x13, 0x02, 0x21, 0x30, 0x08, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30,
+    0x00, 0x21, 0x30, 0x00, 0x21, 0x30, 0x00, 0x21, 0x30, 0x0F, 0x05, 0x21, 0x30, 0x04, 0x21, 0x30,
+    0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x08, 0x21, 0x30, 0x04, 0x21, 0x30, 0x01,
+    0x13, 0x02, 0x21, 0x30, 0x05, 0x31, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x31, 0x21,
+    0x00, 0x30, 0x21, 0x30, 0x00, 0x21, 0x30, 0x0F, 0x05, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21,
+    0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x08, 0x21, 0x30, 0x04, 0x21, 0x30, 0x01, 0x13, 0x02,
+    0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x23, 0x30, 0x00, 0x23,
+    0x30, 0x00, 0x21, 0x30, 0x0F, 0x05, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x04, 0x21,
+    0x30, 0x00, 0x21, 0x30, 0x08, 0x21, 0x30, 0x04, 0x21, 0x30, 0x01, 0x13, 0x02, 0x21, 0x00, 0x34,
+    0x21, 0x01, 0x21, 0x00, 0x34, 0x21, 0x01, 0x23, 0x01, 0x23, 0x30, 0x00, 0x21, 0x38, 0x0C, 0x21,
+    0x00, 0x34, 0x21, 0x01, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x38, 0x00, 0x21, 0x35, 0x21,
+    0x02, 0x13, 0x04, 0x25, 0x30, 0x04, 0x25, 0x30, 0x02, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x29,
+    0x30, 0x0E, 0x25, 0x30, 0x02, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x29, 0x30, 0x00, 0x27, 0x30,
+    0x03, 0x13, 0x04, 0x25, 0x05, 0x25, 0x03, 0x21, 0x05, 0x21, 0x01, 0x29, 0x0F, 0x00, 0x25, 0x03,
+    0x21, 0x05, 0x21, 0x01, 0x29, 0x01, 0x27, 0x04, 0x13, 0x0F, 0x60, 0x13, 0x0F, 0x60, 0x13, 0x0F,
+    0x60, 0x1F, 0xDA,
+};
+
+#define ASSET_SPLASH_W 100
+#define ASSET_SPLASH_H 50
+#define ASSET_SPLASH_FNV 0x30BAB87A8E60AADFULL //FNV-1a of the RGB565 pixels in stream order
+const uint8_t asset_splash[] PROGMEM = {
+    0x64, 0x32, 0x04, 0x9F, 0xCF, 0x45, 0x41, 0xDE, 0x1B, 0x92, 0x1A, 0x1F, 0xBA, 0x0F, 0x50, 0x13,
+    0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F,
+    0x50, 0x13, 0x08, 0x10, 0x04, 0x10, 0x02, 0x10, 0x00, 0x14, 0x00, 0x13, 0x01, 0x13, 0x09, 0x10,
+    0x03, 0x12, 0x07, 0x10, 0x04, 0x14, 0x00, 0x10, 0x02, 0x10, 0x02, 0x10, 0x0B, 0x13, 0x08, 0x10,
+    0x04, 0x10, 0x01, 0x10, 0x01, 0x10, 0x08, 0x10, 0x04, 0x10, 0x08, 0x10, 0x02, 0x10, 0x02, 0x10,
+    0x06, 0x10, 0x04, 0x10, 0x04, 0x10, 0x02, 0x10, 0x02, 0x10, 0x0B, 0x13, 0x08, 0x10, 0x04, 0x10,
+    0x00, 0x10, 0x02, 0x10, 0x08, 0x10, 0x04, 0x10, 0x08, 0x10, 0x02, 0x10, 0x02, 0x10, 0x06, 0x10,
+    0x04, 0x10, 0x04, 0x10, 0x02, 0x10, 0x02, 0x10, 0x0B, 0x13, 0x08, 0x13, 0x01, 0x13, 0x01, 0x13,
+    0x02, 0x12, 0x02, 0x12, 0x09, 0x10, 0x02, 0x10, 0x02, 0x10, 0x06, 0x13, 0x01, 0x10, 0x04, 0x14,
+    0x02, 0x10, 0x0B, 0x13, 0x08, 0x10, 0x02, 0x10, 0x00, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10,
+    0x04, 0x10, 0x0C, 0x10, 0x02, 0x10, 0x02, 0x10, 0x06, 0x10, 0x02, 0x10, 0x00, 0x10, 0x04, 0x10,
+    0x02, 0x10, 0x01, 0x10, 0x00, 0x10, 0x0A, 0x13, 0x08, 0x10, 0x02, 0x10, 0x00, 0x10, 0x02, 0x10,
+    0x00, 0x10, 0x04, 0x10, 0x04, 0x10, 0x0C, 0x10, 0x02, 0x10, 0x02, 0x10, 0x06, 0x10, 0x02, 0x10,
+    0x00, 0x10, 0x04, 0x10, 0x02, 0x10, 0x00, 0x10, 0x02, 0x10, 0x09, 0x13, 0x08, 0x13, 0x01, 0x13,
+    0x01, 0x14, 0x01, 0x13, 0x01, 0x13, 0x06, 0x14, 0x01, 0x12, 0x07, 0x13, 0x01, 0x10, 0x05, 0x12,
+    0x01, 0x10, 0x02, 0x10, 0x09, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F,
+    0x50, 0x13, 0x0F, 0x14, 0x23, 0x02, 0x22, 0x01, 0x20, 0x02, 0x20, 0x00, 0x23, 0x0F, 0x16, 0x13,
+    0x0F, 0x14, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x01, 0x20, 0x01, 0x20, 0x02, 0x20, 0x0F,
+    0x15, 0x13, 0x0F, 0x14, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x02, 0x20, 0x02,
+    0x20, 0x0F, 0x15, 0x13, 0x0F, 0x14, 0x23, 0x03, 0x20, 0x02, 0x23, 0x01, 0x20, 0x02, 0x20, 0x0F,
+    0x15, 0x13, 0x0F, 0x14, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00, 0x20, 0x02,
+    0x20, 0x0F, 0x15, 0x13, 0x0F, 0x14, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x02, 0x20, 0x00,
+    0x20, 0x02, 0x20, 0x0F, 0x15, 0x13, 0x0F, 0x14, 0x23, 0x02, 0x22, 0x01, 0x23, 0x01, 0x23, 0x0F,
+    0x16, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x00, 0x35, 0x03, 0x39,
+    0x03, 0x35, 0x05, 0x35, 0x03, 0x31, 0x05, 0x31, 0x05, 0x31, 0x0F, 0x00, 0x13, 0x0E, 0x25, 0x30,
+    0x02, 0x29, 0x30, 0x02, 0x25, 0x30, 0x04, 0x25, 0x30, 0x02, 0x21, 0x30, 0x04, 0x21, 0x30, 0x04,
+    0x21, 0x30, 0x0F, 0x00, 0x13, 0x0D, 0x30, 0x25, 0x00, 0x31, 0x00, 0x29, 0x03, 0x25, 0x04, 0x30,
+    0x25, 0x00, 0x31, 0x00, 0x21, 0x30, 0x03, 0x30, 0x21, 0x05, 0x21, 0x30, 0x0F, 0x00, 0x13, 0x0C,
+    0x21, 0x30, 0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x04, 0x21,
+    0x30, 0x00, 0x21, 0x30, 0x02, 0x21, 0x30, 0x06, 0x21, 0x30, 0x0F, 0x00, 0x13, 0x0C, 0x21, 0x30,
+    0x04, 0x21, 0x01, 0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x04, 0x21, 0x01, 0x21, 0x30,
+    0x01, 0x30, 0x21, 0x07, 0x21, 0x30, 0x0F, 0x00, 0x13, 0x0C, 0x21, 0x30, 0x08, 0x21, 0x30, 0x0C,
+    0x21, 0x30, 0x04, 0x21, 0x30, 0x08, 0x21, 0x30, 0x00, 0x21, 0x30, 0x08, 0x21, 0x30, 0x0F, 0x00,
+    0x13, 0x0C, 0x21, 0x30, 0x08, 0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x08, 0x21, 0x31,
+    0x21, 0x09, 0x21, 0x30, 0x0F, 0x00, 0x13, 0x0C, 0x21, 0x30, 0x08, 0x21, 0x30, 0x0C, 0x21, 0x30,
+    0x04, 0x21, 0x30, 0x08, 0x23, 0x30, 0x0A, 0x21, 0x30, 0x0F, 0x00, 0x13, 0x0C, 0x21, 0x30, 0x08,
+    0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x08, 0x23, 0x00, 0x31, 0x07, 0x30, 0x21, 0x00,
+    0x31, 0x0D, 0x13, 0x0C, 0x21, 0x30, 0x08, 0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x08,
+    0x21, 0x30, 0x00, 0x21, 0x30, 0x06, 0x21, 0x30, 0x00, 0x21, 0x30, 0x0D, 0x13, 0x0C, 0x21, 0x30,
+    0x05, 0x31, 0x00, 0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x05, 0x31, 0x00, 0x21, 0x30,
+    0x00, 0x21, 0x00, 0x31, 0x03, 0x30, 0x21, 0x01, 0x21, 0x00, 0x31, 0x0B, 0x13, 0x0C, 0x21, 0x30,
+    0x04, 0x21, 0x30, 0x00, 0x21, 0x30, 0x0C, 0x21, 0x30, 0x04, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00,
+    0x21, 0x30, 0x02, 0x21, 0x30, 0x02, 0x21, 0x30, 0x04, 0x21, 0x30, 0x0B, 0x13, 0x0C, 0x21, 0x00,
+    0x34, 0x21, 0x01, 0x21, 0x30, 0x0B, 0x30, 0x21, 0x32, 0x02, 0x21, 0x00, 0x34, 0x21, 0x01, 0x21,
+    0x30, 0x02, 0x21, 0x00, 0x31, 0x00, 0x21, 0x30, 0x04, 0x21, 0x30, 0x0B, 0x13, 0x0E, 0x25, 0x30,
+    0x02, 0x21, 0x30, 0x0A, 0x25, 0x30, 0x04, 0x25, 0x30, 0x02, 0x21, 0x30, 0x04, 0x21, 0x30, 0x00,
+    0x21, 0x30, 0x04, 0x21, 0x30, 0x0B, 0x13, 0x0E, 0x25, 0x03, 0x21, 0x0B, 0x25, 0x05, 0x25, 0x03,
+    0x21, 0x05, 0x21, 0x01, 0x21, 0x05, 0x21, 0x0C, 0x13, 0x0F, 0x50, 0x13, 0x0F, 0x50, 0x13, 0x0F,
+    0x50, 0x1F, 0xBA,
+};
+
+#endif /* ASSETS_H */
@@ -0,0 +1,261 @@
+#ifndef BOOT_H
+#define BOOT_H
+
+#include <avr/io.h>
+#include <util/delay.h>
+#include <stdlib.h>
+#include <string.h>
+#include "game.h"
+
+//FAST BOOT
+//ST7735 and HD44780 bring-up as two synchSMs that never block: every state sets the time it
+//may tick again and boot_run() ticks whichever is due off Timer1, so the panel's long waits
+//and the LCD's command gaps overlap instead of adding up
+//
+//waits are the datasheet minimums
+//  ST7735   reset low >= 10 us, then 120 ms (5 ms if the panel was asleep, but a reset of only
+//           the MCU can find it awake), SLPOUT, 5 ms before the next command, 120 ms before DISPON
+//           SWRESET is skipped, the hardware reset just did the same
+//           interface and RAM work while the panel sleeps, the background is written in that wait
+//  HD44780  40 ms from power up, 37 us per command or character, 1.52 ms after clear
+//
+//time to first frame is DISPON with the background already in RAM, counted from boot_run()
+
+#define BOOT_TFT_RESET_US 20
+#define BOOT_TFT_RESET_WAIT_US 120000UL
+#define BOOT_TFT_COMMAND_US 5000UL  //after SLPOUT
+#define BOOT_TFT_SLPOUT_US 120000UL
+#define BOOT_TFT_FILL_CHUNK 128     //pixels per tick, about 0.4 ms of SPI
+static_assert(BOOT_TFT_FILL_CHUNK % 2 == 0, "RGB444 chunks must end on a whole pixel pair");
+#define BOOT_LCD_POWER_US 40000UL
+#define BOOT_LCD_COMMAND_US 50
+#define BOOT_LCD_CLEAR_US 2000
+#define BOOT_LCD_QUEUE 40
+
+unsigned long boot_overflows = 0;      //Timer1 wraps, counted by polling
+unsigned long boot_tft_at = 0;         //time the TFT machine ticks next
+unsigned long boot_lcd_at = 0;         //time the LCD machine ticks next
+unsigned long boot_slpout_us = 0;
+unsigned int boot_fill_left = 0;
+unsigned long boot_first_frame_us = 0;
+
+//LCD bytes in send order, NIBBLE is the lone 4-bit switch nibble lcd_init opens with
+enum BOOT_LCD_KIND {BOOT_LCD_CMD, BOOT_LCD_DATA, BOOT_LCD_NIBBLE};
+struct boot_lcd_byte {
+    uint8_t data;
+    uint8_t kind;
+};
+struct boot_lcd_byte boot_lcd_queue[BOOT_LCD_QUEUE];
+uint8_t boot_lcd_len = 0;
+uint8_t boot_lcd_pos = 0;
+
+
+//Timer1 at /64 is 4 us a count, wraps every 262 ms, the boot loop polls far more often
+unsigned long boot_now_us(){
+    uint16_t t = TCNT1;
+    if (TIFR1 & (1 << TOV1)){
+        TIFR1 = (1 << TOV1);
+        boot_overflows++;
+        t = TCNT1; //the wrap may have come after the first read
+    }
+    return ((boot_overflows << 16) | t) * 4;
+}
+
+void boot_lcd_push(uint8_t data, uint8_t kind){
+    if (boot_lcd_len < BOOT_LCD_QUEUE){
+        boot_lcd_queue[boot_lcd_len].data = data;
+        boot_lcd_queue[boot_lcd_len].kind = kind;
+        boot_lcd_len++;
+    }
+}
+
+void boot_lcd_text(uint8_t line, uint8_t pos, const char *str){
+    boot_lcd_push((0x80 | (line << 6)) + pos, BOOT_LCD_CMD);
+    for (int i = 0; str[i] != '\0'; i++){
+        boot_lcd_push(str[i], BOOT_LCD_DATA);
+    }
+}
+
+//same from flash
+void boot_lcd_text_P(uint8_t line, uint8_t pos, const char *str){
+    char ch;
+    boot_lcd_push((0x80 | (line << 6)) + pos, BOOT_LCD_CMD);
+    while ((ch = pgm_read_byte(str++)) != '\0'){
+        boot_lcd_push(ch, BOOT_LCD_DATA);
+    }
+}
+
+//lcd_init followed by what scoreboard_init writes, as one queue
+void boot_lcd_script(){
+    char buf[12];
+    boot_lcd_push(0x20, BOOT_LCD_NIBBLE);
+    boot_lcd_push(LCD_CMD_4BIT_2ROW_5X7, BOOT_LCD_CMD);
+    boot_lcd_push(LCD_CMD_DISPLAY_CURSOR_BLINK, BOOT_LCD_CMD);
+    boot_lcd_push(LCD_CMD_CLEAR_DISPLAY, BOOT_LCD_CMD);
+
+    boot_lcd_text_P(0, 0, scoreboard_score);
+    itoa(score, buf, 10);
+    boot_lcd_text(0, 16 - strlen(buf), buf);
+    boot_lcd_text_P(1, 0, scoreboard_best);
+    itoa(high_score, buf, 10);
+    boot_lcd_text(1, 16 - strlen(buf), buf);
+}
+
+enum BOOT_TFT_STATES {TFT_INIT, TFT_RESET_LOW, TFT_RESET_WAIT, TFT_SLPOUT, TFT_CONFIG, TFT_FILL, TFT_DISPON, TFT_DONE};
+int TickBootTFT(int state){
+    unsigned long now = boot_now_us();
+
+    //transitions
+    switch(state){
+        case(TFT_INIT):
+            state = TFT_RESET_LOW;
+            break;
+
+        case(TFT_RESET_LOW):
+            state = TFT_RESET_WAIT;
+            break;
+
+        case(TFT_RESET_WAIT):
+            state = TFT_SLPOUT;
+            break;
+
+        case(TFT_SLPOUT):
+            state = TFT_CONFIG;
+            break;
+
+        case(TFT_CONFIG):
+            state = TFT_FILL;
+            break;
+
+        case(TFT_FILL):
+            state = (boot_fill_left > 0) ? TFT_FILL : TFT_DISPON;
+            break;
+
+        case(TFT_DISPON):
+        case(TFT_DONE):
+            state = TFT_DONE;
+            break;
+    }
+
+    //state actions
+    switch(state){
+        case(TFT_RESET_LOW):
+            PORTB &= ~RESET_PIN;
+            boot_tft_at = now + BOOT_TFT_RESET_US;
+            break;
+
+        case(TFT_RESET_WAIT):
+            PORTB |= RESET_PIN;
+            boot_tft_at = now + BOOT_TFT_RESET_WAIT_US;
+            break;
+
+        case(TFT_SLPOUT):
+            SendCommand(SLPOUT);
+            boot_slpout_us = now;
+            boot_tft_at = now + BOOT_TFT_COMMAND_US;
+            break;
+
+        case(TFT_CONFIG):
+            ST7735_config();
+            SetWriteWindow(XS, YS, XE, YE);
+            boot_fill_left = (XE - XS + 1) * (YE - YS + 1);
+            boot_tft_at = now;
+            break;
+
+        case(TFT_FILL): {
+            unsigned int n = (boot_fill_left < BOOT_TFT_FILL_CHUNK) ? boot_fill_left : BOOT_TFT_FILL_CHUNK;
+            StreamPixels(n, BACKGROUND);
+            boot_fill_left -= n;
+            //the last chunk waits out the rest of the sleep-out time
+            boot_tft_at = (boot_fill_left > 0) ? now : boot_slpout_us + BOOT_TFT_SLPOUT_US;
+            break;
+        }
+
+        case(TFT_DISPON):
+            SendCommand(DISPON);
+            boot_first_frame_us = now;
+            break;
+
+        default:
+            break;
+    }
+    return state;
+}
+
+enum BOOT_LCD_STATES {LCD_INIT, LCD_POWER, LCD_SEND, LCD_DONE};
+int TickBootLCD(int state){
+    unsigned long now = boot_now_us();
+
+    //transitions
+    switch(state){
+        case(LCD_INIT):
+            state = LCD_POWER;
+            break;
+
+        case(LCD_POWER):
+        case(LCD_SEND):
+            state = (boot_lcd_pos < boot_lcd_len) ? LCD_SEND : LCD_DONE;
+            break;
+
+        case(LCD_DONE):
+            break;
+    }
+
+    //state actions
+    switch(state){
+        case(LCD_POWER):
+            DATA_DDR = (1<<LCD_D7) | (1<<LCD_D6) | (1<<LCD_D5) | (1<<LCD_D4);
+            CTL_DDR |= (1<<LCD_EN) | (1<<LCD_RS);
+            boot_lcd_at = BOOT_LCD_POWER_US; //counted from boot_run(), main() gets there within a few ms of power up
+            break;
+
+        case(LCD_SEND): {
+            struct boot_lcd_byte *b = &boot_lcd_queue[boot_lcd_pos++];
+            if (b->kind == BOOT_LCD_NIBBLE){
+                lcd_pulse_nibble(b->data, 0);
+            }
+            else {
+                lcd_send_fast(b->data, b->kind == BOOT_LCD_DATA);
+            }
+            boot_lcd_at = now + ((b->kind == BOOT_LCD_CMD && b->data == LCD_CMD_CLEAR_DISPLAY) ? BOOT_LCD_CLEAR_US : BOOT_LCD_COMMAND_US);
+            break;
+        }
+
+        default:
+            break;
+    }
+    return state;
+}
+
+//brings up both displays, returns once the TFT shows the background and the LCD the scoreboard
+//with NO_LCD only the TFT
+void boot_run(){
+    TCCR1A = 0x00;
+    TCCR1B = (1 << CS11) | (1 << CS10); //normal mode, /64
+    TCNT1 = 0;
+    TIFR1 = (1 << TOV1);
+    boot_overflows = 0;
+
+    //the scoreboard, on the TFT HUD from the first frame TickDraw draws and on the LCD here
+    hud_value[0] = score;
+    hud_value[1] = high_score;
+#ifndef NO_LCD
+    boot_lcd_script();
+    int lcd = LCD_INIT;
+#else
+    int lcd = LCD_DONE;
+#endif
+    int tft = TFT_INIT;
+    while (tft != TFT_DONE || lcd != LCD_DONE){
+        unsigned long now = boot_now_us();
+        if (tft != TFT_DONE && now >= boot_tft_at){
+            tft = TickBootTFT(tft);
+        }
+        if (lcd != LCD_DONE && now >= boot_lcd_at){
+            lcd = TickBootLCD(lcd);
+        }
+    }
+    //Timer1 runs on at /64, it is CLOCK_NOW in helper.h from here
+}
+
+#endif /* BOOT_H */
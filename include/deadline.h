@@ -0,0 +1,154 @@
+#ifndef DEADLINE_H
+#define DEADLINE_H
+
+#include <avr/io.h>
+#include <avr/wdt.h>
+#include "helper.h"
+#include "serialATmega.h"
+#include "snapshot.h"
+
+//DEADLINE MONITOR
+//a tick function that never returns, an EEPE or SPIF spin on a part that stopped answering,
+//freezes the game with the scheduler's interrupt masked. the watchdog runs from deadline_start() on and TimerISR
+//kicks it as each cycle starts and ends, a cycle that hangs stops the kicks and it resets the board
+//
+//TimerISR writes the task it is about to tick and the tick number into a .noinit record, the
+//reset leaves it alone, so after the reset it still names what hung. every DEADLINE_KEEP healthy
+//cycles it also packs the game into it, the same payload snapshot.h keeps in EEPROM, and the board
+//comes back on that game's paused screen. a pack walks every column, so it is not every cycle,
+//the game can come back up to DEADLINE_KEEP ticks before the hang
+//
+//  W watchdog    the reset came from the watchdog, the lines below only if the record survived
+//  W task <n>    0-5 in task table order, DEADLINE_SCHED for remote_poll and snapshot_check
+//  W tick <n>    scheduler tick of the cycle that hung
+//  W resumed     or W lost, no whole game copy (a run that was over) and the EEPROM snapshot is next
+//
+//the timeout has to cover the longest healthy gap between kicks. a remote dump or save runs far
+//longer than it inside one cycle, 'f' about 1.6 s of UART in a rich build and 'e' 0.84 s of EEPROM
+//writes, so serial_char and EEPROM_write_score kick once a byte as well, after their wait. what is
+//left is a few ms between bytes and the 100 ms between cycles, a part that stops answering still
+//stops the kicks. host_sim watchdog holds every command to the timeout on the host's board clock
+//after a watchdog reset the watchdog stays on at its shortest timeout, deadline_early turns it
+//off from .init3 before the C runtime, or the board would reset again in the middle of boot
+//
+//DEADLINE_TEST (env:deadline_test) hangs TickDraw once at DEADLINE_HANG_TICK, a spin on a flag nothing
+//sets, scripts/deadline_check.py runs it under simavr and waits for the report
+
+#define DEADLINE_TIMEOUT WDTO_500MS
+#define DEADLINE_MAGIC 0xD7
+#define DEADLINE_SCHED 0xFE   //the scheduler's own work around the tasks
+#define DEADLINE_IDLE 0xFF    //between cycles
+#define DEADLINE_KEEP 8       //cycles between game copies, power of two
+
+#ifndef DEADLINE_HANG_TICK
+#define DEADLINE_HANG_TICK 50
+#endif
+#define DEADLINE_HANG_TASK 5  //TickDraw
+
+#ifdef HOST_BUILD
+  #define DEADLINE_NOINIT
+#else
+  #define DEADLINE_NOINIT __attribute__((section(".noinit")))
+#endif
+
+struct deadline_record {
+    uint8_t magic;          //DEADLINE_MAGIC once deadline_start has set the record up
+    uint8_t task;           //running when the watchdog fired, DEADLINE_IDLE if nothing was
+    unsigned long tick;
+    uint8_t len;            //game payload, 0 while there is none
+    uint8_t game[SNAPSHOT_PAYLOAD_MAX];
+    uint8_t check;          //sum of len and game plus DEADLINE_MAGIC, zero when the copy is whole
+};
+
+GAME_LOCAL volatile struct deadline_record deadline_rec DEADLINE_NOINIT;
+GAME_LOCAL uint8_t deadline_mcusr DEADLINE_NOINIT; //MCUSR at reset, .bss is cleared after .init3
+
+#ifndef HOST_BUILD
+//runs from .init3, the stack is set up, .bss is not cleared yet
+void deadline_early() __attribute__((naked, used, section(".init3")));
+void deadline_early(){
+    deadline_mcusr = MCUSR;
+    MCUSR = 0;
+    wdt_disable();
+}
+#endif
+
+//the last reset came from the watchdog
+inline bool deadline_tripped(){
+    return deadline_mcusr & (1 << WDRF);
+}
+
+//after boot, before TimerOn. the record is forgotten, a later reset reports on this run only
+void deadline_start(){
+    deadline_rec.magic = DEADLINE_MAGIC;
+    deadline_rec.task = DEADLINE_IDLE;
+    deadline_rec.tick = 0;
+    deadline_rec.len = 0;
+    wdt_enable(DEADLINE_TIMEOUT);
+}
+
+//before each task, two stores
+inline void deadline_enter(uint8_t task, unsigned long tick){
+    deadline_rec.task = task;
+    deadline_rec.tick = tick;
+#ifdef DEADLINE_TEST
+    if (task == DEADLINE_HANG_TASK && tick == DEADLINE_HANG_TICK && !(deadline_mcusr & (1 << WDRF))){
+        while (deadline_rec.task == task){} //a flag nothing will set, an EEPE or SPIF spin stand-in
+    }
+#endif
+}
+
+//first thing in a cycle
+inline void deadline_begin(unsigned long tick){
+    wdt_reset();
+    deadline_enter(DEADLINE_SCHED, tick);
+}
+
+//last thing in a cycle
+inline void deadline_leave(){
+    deadline_rec.task = DEADLINE_IDLE;
+    wdt_reset();
+}
+
+//sum of len and the game bytes, RAM only has to survive the reset, the CRC snapshot.h puts on
+//EEPROM would cost more than the pack
+uint8_t deadline_sum(uint8_t len){
+    uint8_t sum = DEADLINE_MAGIC + len;
+    for (uint8_t i = 0; i < len; i++){
+        sum += deadline_rec.game[i];
+    }
+    return sum;
+}
+
+//len bytes of the game are in deadline_rec.game, seals them
+void deadline_seal(uint8_t len){
+    deadline_rec.len = len;
+    deadline_rec.check = -deadline_sum(len);
+}
+
+//the game copy if it survived, its length, else -1
+int deadline_game(){
+    uint8_t len = deadline_rec.len;
+    if (len == 0 || len > SNAPSHOT_PAYLOAD_MAX || (uint8_t)(deadline_sum(len) + deadline_rec.check) != 0){
+        return -1;
+    }
+    return len;
+}
+
+//name is in flash
+void deadline_line(const char *name, unsigned long value){
+    serial_report_P('W', name, value);
+}
+
+//after a watchdog reset, what hung, returns false if the record did not survive
+bool deadline_report(){
+    serial_println_P(PSTR("W watchdog"));
+    if (deadline_rec.magic != DEADLINE_MAGIC){
+        return false;
+    }
+    deadline_line(PSTR("task"), deadline_rec.task);
+    deadline_line(PSTR("tick"), deadline_rec.tick);
+    return true;
+}
+
+#endif /* DEADLINE_H */
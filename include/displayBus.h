@@ -0,0 +1,87 @@
+#ifndef DISPLAYBUS_H
+#define DISPLAYBUS_H
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+//DISPLAY BUS
+//the byte transport under the ST7735 driver, picked at build time
+//
+//  default             hardware SPI, SCK PB5, MOSI PB3
+//                      SPDR has no transmit buffer, every byte waits for SPIF before the
+//                      next can be written, so each one is followed by an idle gap
+//  DISPLAY_BUS_MSPIM   USART0 in master SPI mode, SCK is XCK0 (PD4), MOSI is TXD0 (PD1)
+//                      UDR0 is double buffered, the next byte is queued while the current
+//                      one shifts out and bytes go back to back
+//
+//BUS_SEND may return before the byte is on the wire, BUS_FLUSH waits until the last one has
+//shifted out. spiAVR.h flushes before CS goes high or DC changes
+//
+//MSPIM PIN CONFLICTS
+//  uno (328P)  XCK0 is PD4, the LCD's D4, so the LCD can not share the build, it is an #error
+//              without NO_LCD. TXD0 is the console's TX, serial output is dropped while USART0
+//              is the display bus and remote.h's receiver stays off
+//  1284        XCK0 is PB0, the panel's RESET, and USART1 puts XCK1 on PD4 and TXD1 on the
+//              LCD's EN (PD3), either one means rewiring before the backend can be used
+//
+//the MSPIM clock is fosc / (2 * (DISPLAY_BUS_UBRR + 1)), the default matches SPI's fosc/4 so
+//the two backends only differ in the gaps, 0 runs it at fosc/2
+
+#ifndef DISPLAY_BUS_UBRR
+#define DISPLAY_BUS_UBRR 1
+#endif
+
+#ifdef DISPLAY_BUS_MSPIM
+
+#if defined(__AVR_ATmega328P__) && !defined(NO_LCD)
+  #error "DISPLAY_BUS_MSPIM clocks on PD4, the LCD's D4, build it with NO_LCD"
+#endif
+
+#define BUS_SCK  (1 << PORTD4)  // XCK0
+#define BUS_MOSI (1 << PORTD1)  // TXD0
+
+void BUS_INIT(){
+    UBRR0 = 0; //must be zero while the transmitter is enabled
+    DDRD |= BUS_SCK | BUS_MOSI;
+    UCSR0C = (1 << UMSEL01) | (1 << UMSEL00); //master SPI, MSB first, mode 0 like the SPI backend
+    UCSR0B = (1 << TXEN0);                    //transmit only, no receive interrupts
+    UBRR0 = DISPLAY_BUS_UBRR;
+}
+
+//TXC0 is cleared after the byte is queued, with interrupts held: a nested ISR between the two
+//could let the previous byte (or this one) finish, and BUS_FLUSH would return early or never.
+//a plain write, |= would also clear the other write-one flags it read back
+inline void BUS_SEND(uint8_t data){
+    while (!(UCSR0A & (1 << UDRE0)));  // Wait for room in the buffer
+    uint8_t sreg = SREG;
+    cli();
+    UDR0 = data;
+    UCSR0A = (UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0); // write one to clear, sets again once the buffer runs dry
+    SREG = sreg;
+}
+
+inline void BUS_FLUSH(){
+    while (!(UCSR0A & (1 << TXC0)));
+}
+
+#else
+
+#define BUS_SCK  (1 << PORTB5)  // Pin 13 - SCK
+#define BUS_MOSI (1 << PORTB3)  // Pin 11 - MOSI
+
+void BUS_INIT(){
+    DDRB |= BUS_SCK | BUS_MOSI;
+    SPCR |= (1 << SPE) | (1 << MSTR);  // Enable SPI, Master mode
+}
+
+inline void BUS_SEND(uint8_t data){
+    SPDR = data;  // Set data to transmit
+    while (!(SPSR & (1 << SPIF)));  // Wait until done transmitting
+}
+
+inline void BUS_FLUSH(){
+    //BUS_SEND already waited for the byte
+}
+
+#endif
+
+#endif /* DISPLAYBUS_H */
@@ -0,0 +1,127 @@
+#ifndef EVENTTRACE_H
+#define EVENTTRACE_H
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include "helper.h"
+#include "serialATmega.h"
+
+//EVENT TRACE (EVENT_TRACE)
+//a RAM ring of timestamped begin/end events, enough to see what one scheduler cycle spent its
+//time on. the remote 'f' command dumps it and scripts/trace_to_chrome.py turns the dump into a
+//Chrome trace (chrome://tracing, ui.perfetto.dev)
+//
+//  TRACE_BEGIN(id) / TRACE_END(id)   a span, they nest like calls
+//  TRACE_MARK(id)                    an instant
+//
+//spans: each tick function, the scheduler cycle (TimerISR), TFT pixel streams, LCD bytes.
+//marks: the UART RX and EE_READY interrupts and the sound ISR's step changes
+//a cycle with a draw tick is 66 events, the longest host_sim has seen 84. the 1 ms Timer2 interrupt, the sound ISR's edges and the window
+//commands before every stream would push it out of the ring, they are left out, the window
+//commands are the gap in front of each pixel stream
+//
+//EVENT LAYOUT (3 bytes)
+//  [0..1] CLOCK_NOW, 4 us a count   [2] id, TRACE_B or TRACE_E on top
+//the clock wraps every 262 ms and every cycle records something, so the converter can unwrap
+//the counts
+//
+//recording is a timer read and three stores with interrupts held off, the avr_bench
+//"trace_event" line. without EVENT_TRACE the macros are empty and the ring is not there
+
+#define TRACE_B 0x40
+#define TRACE_E 0x80
+#define TRACE_ID_MASK 0x3F
+#define TRACE_US_PER_COUNT CLOCK_US_PER_COUNT
+
+//keep in step with NAMES in scripts/trace_to_chrome.py
+enum TRACE_ID {
+    TRACE_TASK = 0,     //+ task index, 0-5 in task table order
+    TRACE_SCHED = 8,    //one TimerISR call
+    TRACE_SPI,          //a pixel stream to the TFT
+    TRACE_LCD,          //one LCD command or character
+    TRACE_RX,           //UART RX interrupt
+    TRACE_SOUND,        //sound ISR loads the next step
+    TRACE_EEPROM        //EE_READY interrupt, one snapshot byte
+};
+
+#ifdef EVENT_TRACE
+
+#ifndef EVENT_TRACE_SIZE
+  #if RAMEND > 0x8FF
+    #define EVENT_TRACE_SIZE 256 //1284, 768 bytes, three whole cycles
+  #else
+    #define EVENT_TRACE_SIZE 128 //uno, 384 bytes, one whole cycle behind the one that dumps
+  #endif
+#endif
+
+struct trace_event_t {
+    uint16_t time;
+    uint8_t id;
+};
+
+GAME_LOCAL struct trace_event_t trace_ring[EVENT_TRACE_SIZE];
+GAME_LOCAL volatile uint8_t trace_head = 0;      //next slot, wraps with the mask
+GAME_LOCAL volatile bool trace_wrapped = false;  //the ring has been all the way round
+
+inline void trace_event(uint8_t id){
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t i = trace_head;
+    trace_ring[i].time = CLOCK_NOW();
+    trace_ring[i].id = id;
+    i = (i + 1) & (EVENT_TRACE_SIZE - 1);
+    trace_head = i;
+    if (i == 0){
+        trace_wrapped = true;
+    }
+    SREG = sreg;
+}
+
+#define TRACE_BEGIN(id) trace_event((id) | TRACE_B)
+#define TRACE_END(id) trace_event((id) | TRACE_E)
+#define TRACE_MARK(id) trace_event(id)
+
+//empties the ring, the clock has been running since boot_run
+void trace_init(){
+    trace_head = 0;
+    trace_wrapped = false;
+}
+
+//"F" then 6 hex digits an event, oldest first: the count, then the id. the ring keeps recording
+//after, a dump sent mid-run holds the cycles just before it
+void trace_dump(){
+    uint8_t sreg = SREG;
+    cli();
+    uint8_t head = trace_head;
+    uint16_t n = trace_wrapped ? EVENT_TRACE_SIZE : head;
+    uint8_t i = trace_wrapped ? head : 0;
+    serial_char('F');
+    for (uint16_t k = 0; k < n; k++){
+        struct trace_event_t e = trace_ring[i];
+        serial_hex(e.time >> 12);
+        serial_hex(e.time >> 8);
+        serial_hex(e.time >> 4);
+        serial_hex(e.time);
+        serial_hex(e.id >> 4);
+        serial_hex(e.id);
+        i = (i + 1) & (EVENT_TRACE_SIZE - 1);
+    }
+    serial_char('\n');
+    SREG = sreg;
+}
+
+#else
+
+#define TRACE_BEGIN(id) ((void)0)
+#define TRACE_END(id) ((void)0)
+#define TRACE_MARK(id) ((void)0)
+
+inline void trace_init(){}
+
+void trace_dump(){
+    serial_println_P(PSTR("E notrace"));
+}
+
+#endif
+
+#endif /* EVENTTRACE_H */
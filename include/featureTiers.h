@@ -0,0 +1,57 @@
+#ifndef FEATURETIERS_H
+#define FEATURETIERS_H
+
+//FEATURE TIERS
+//one flag picks what a build keeps in SRAM, the part decides what fits
+//
+//  FEATURES_LEAN (env:uno, ATmega328P, 2 KB)     no digit cache (DrawDigit reads the glyph), a
+//                                                64 byte replay trace, 8 remote events, 16 byte
+//                                                RX ring, no shadow, no trace
+//  default (env:part1 and the single-flag envs)  the buffers each header picks on its own
+//  FEATURES_RICH (env:rich, ATmega1284P, 16 KB)  SHADOW_FB, EVENT_TRACE with the 256 event ring,
+//                                                a 240 byte replay trace, 32 remote events
+//
+//a tier only sets the defaults, -DREPLAY_SIZE=96 on top of it still wins. scripts/budget_report.py
+//runs after every AVR build and prints what each section and the biggest symbols cost against the
+//part, the README's "Build Matrix" has the numbers for each tier
+
+#if defined(FEATURES_LEAN) && defined(FEATURES_RICH)
+  #error "pick one of FEATURES_LEAN and FEATURES_RICH"
+#endif
+
+#ifdef FEATURES_LEAN
+  #ifndef FONT_NO_CACHE
+    #define FONT_NO_CACHE
+  #endif
+  #ifndef REPLAY_SIZE
+    #define REPLAY_SIZE 64
+  #endif
+  #ifndef REMOTE_EVENT_SIZE
+    #define REMOTE_EVENT_SIZE 8
+  #endif
+  #ifndef REMOTE_RX_SIZE
+    #define REMOTE_RX_SIZE 16
+  #endif
+#endif
+
+#ifdef FEATURES_RICH
+  #ifndef SHADOW_FB
+    #define SHADOW_FB
+  #endif
+  #ifndef EVENT_TRACE
+    #define EVENT_TRACE
+  #endif
+  #ifndef REPLAY_SIZE
+    #define REPLAY_SIZE 240
+  #endif
+  #ifndef REMOTE_EVENT_SIZE
+    #define REMOTE_EVENT_SIZE 32
+  #endif
+#endif
+
+//the shadow alone is more than an uno's SRAM
+#if defined(SHADOW_FB) && defined(__AVR__) && RAMEND < 0x10FF
+  #error "SHADOW_FB takes 2244 bytes of SRAM, build it for the ATmega1284P (env:shadow, env:rich)"
+#endif
+
+#endif /* FEATURETIERS_H */
@@ -0,0 +1,225 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "helper.h"
+#include "spiAVR.h"
+
+//TEXT ON THE TFT
+//5x7 bitmap font in flash, ' ' to 'Z', lowercase is drawn as uppercase and anything else as ' '
+//
+//FONT LAYOUT (PROGMEM bytes)
+//  5 bytes a glyph, one per column left to right, bit 0 is the top row
+//
+//DrawText streams a whole string through one window, glyphs FONT_PITCH apart with a background
+//column between them. the score digits are drawn often, so font_cache_digits expands 0-9 once
+//into runs in stream order and DrawDigit sends them with StreamRun, no bit reading per pixel
+//FONT_NO_CACHE (FEATURES_LEAN) gives the cache's 200 bytes back, DrawDigit reads the glyph like DrawText
+
+#define FONT_FIRST ' '
+#define FONT_LAST 'Z'
+#define FONT_COLS 5
+#define FONT_ROWS 7
+#define FONT_PITCH (FONT_COLS + 1)
+#define FONT_RUNS 20 //longest digit is 19 runs, checked by host_sim font
+
+const uint8_t font5x7[(FONT_LAST - FONT_FIRST + 1) * FONT_COLS] PROGMEM = {
+    0x00, 0x00, 0x00, 0x00, 0x00, // ' '
+    0x00, 0x00, 0x5F, 0x00, 0x00, // !
+    0x00, 0x07, 0x00, 0x07, 0x00, // "
+    0x14, 0x7F, 0x14, 0x7F, 0x14, // #
+    0x24, 0x2A, 0x7F, 0x2A, 0x12, // $
+    0x23, 0x13, 0x08, 0x64, 0x62, // %
+    0x36, 0x49, 0x55, 0x22, 0x50, // &
+    0x00, 0x05, 0x03, 0x00, 0x00, // '
+    0x00, 0x1C, 0x22, 0x41, 0x00, // (
+    0x00, 0x41, 0x22, 0x1C, 0x00, // )
+    0x14, 0x08, 0x3E, 0x08, 0x14, // *
+    0x08, 0x08, 0x3E, 0x08, 0x08, // +
+    0x00, 0x50, 0x30, 0x00, 0x00, // ,
+    0x08, 0x08, 0x08, 0x08, 0x08, // -
+    0x00, 0x60, 0x60, 0x00, 0x00, // .
+    0x20, 0x10, 0x08, 0x04, 0x02, // /
+    0x3E, 0x51, 0x49, 0x45, 0x3E, // 0
+    0x00, 0x42, 0x7F, 0x40, 0x00, // 1
+    0x42, 0x61, 0x51, 0x49, 0x46, // 2
+    0x21, 0x41, 0x45, 0x4B, 0x31, // 3
+    0x18, 0x14, 0x12, 0x7F, 0x10, // 4
+    0x27, 0x45, 0x45, 0x45, 0x39, // 5
+    0x3C, 0x4A, 0x49, 0x49, 0x30, // 6
+    0x01, 0x71, 0x09, 0x05, 0x03, // 7
+    0x36, 0x49, 0x49, 0x49, 0x36, // 8
+    0x06, 0x49, 0x49, 0x29, 0x1E, // 9
+    0x00, 0x36, 0x36, 0x00, 0x00, // :
+    0x00, 0x56, 0x36, 0x00, 0x00, // ;
+    0x08, 0x14, 0x22, 0x41, 0x00, // <
+    0x14, 0x14, 0x14, 0x14, 0x14, // =
+    0x00, 0x41, 0x22, 0x14, 0x08, // >
+    0x02, 0x01, 0x51, 0x09, 0x06, // ?
+    0x32, 0x49, 0x79, 0x41, 0x3E, // @
+    0x7E, 0x11, 0x11, 0x11, 0x7E, // A
+    0x7F, 0x49, 0x49, 0x49, 0x36, // B
+    0x3E, 0x41, 0x41, 0x41, 0x22, // C
+    0x7F, 0x41, 0x41, 0x22, 0x1C, // D
+    0x7F, 0x49, 0x49, 0x49, 0x41, // E
+    0x7F, 0x09, 0x09, 0x01, 0x01, // F
+    0x3E, 0x41, 0x41, 0x51, 0x32, // G
+    0x7F, 0x08, 0x08, 0x08, 0x7F, // H
+    0x00, 0x41, 0x7F, 0x41, 0x00, // I
+    0x20, 0x40, 0x41, 0x3F, 0x01, // J
+    0x7F, 0x08, 0x14, 0x22, 0x41, // K
+    0x7F, 0x40, 0x40, 0x40, 0x40, // L
+    0x7F, 0x02, 0x04, 0x02, 0x7F, // M
+    0x7F, 0x04, 0x08, 0x10, 0x7F, // N
+    0x3E, 0x41, 0x41, 0x41, 0x3E, // O
+    0x7F, 0x09, 0x09, 0x09, 0x06, // P
+    0x3E, 0x41, 0x51, 0x21, 0x5E, // Q
+    0x7F, 0x09, 0x19, 0x29, 0x46, // R
+    0x46, 0x49, 0x49, 0x49, 0x31, // S
+    0x01, 0x01, 0x7F, 0x01, 0x01, // T
+    0x3F, 0x40, 0x40, 0x40, 0x3F, // U
+    0x1F, 0x20, 0x40, 0x20, 0x1F, // V
+    0x7F, 0x20, 0x18, 0x20, 0x7F, // W
+    0x63, 0x14, 0x08, 0x14, 0x63, // X
+    0x03, 0x04, 0x78, 0x04, 0x03, // Y
+    0x61, 0x51, 0x49, 0x45, 0x43, // Z
+};
+
+inline const uint8_t *font_glyph(char ch){
+    if (ch >= 'a' && ch <= 'z'){
+        ch -= 'a' - 'A';
+    }
+    if (ch < FONT_FIRST || ch > FONT_LAST){
+        ch = ' ';
+    }
+    return &font5x7[(ch - FONT_FIRST) * FONT_COLS];
+}
+
+//pixel of column c in row r, rows counted from the bottom like the panel's
+inline bool font_pixel(const uint8_t *glyph, uint8_t c, uint8_t r){
+    return pgm_read_byte(glyph + c) & (1 << (FONT_ROWS - 1 - r));
+}
+
+//string with its lowest left pixel at (x, y), it must fit on the panel
+void DrawText(uint8_t x, uint8_t y, const char *str, uint16_t fg, uint16_t bg){
+    uint8_t n = 0;
+    while (str[n] != '\0'){
+        n++;
+    }
+    if (n == 0){
+        return;
+    }
+    struct pixel_stream px;
+    px.half = false;
+#ifdef TFT_COLOR_444
+    fg = TFT_444(fg);
+    bg = TFT_444(bg);
+#endif
+
+    SetWriteWindow(x, y, x + n * FONT_PITCH - 2, y + FONT_ROWS - 1);
+    TRACE_BEGIN(TRACE_SPI);
+    PORTB &= ~PIN_SS;   // CS LOW
+    PORTB |= A0;        // DC HIGH (data mode)
+    for (uint8_t r = 0; r < FONT_ROWS; r++){
+        for (uint8_t i = 0; i < n; i++){
+            const uint8_t *glyph = font_glyph(str[i]);
+            for (uint8_t c = 0; c < FONT_COLS; c++){
+                StreamPut(&px, font_pixel(glyph, c, r) ? fg : bg);
+            }
+            if (i + 1 < n){
+                StreamPut(&px, bg);
+            }
+        }
+    }
+    StreamEnd(&px);
+    SPI_DESELECT();     // CS HIGH
+    TRACE_END(TRACE_SPI);
+}
+
+//DIGIT RUN CACHE
+//runs of one digit in stream order, background first (may be 0 long), then they alternate
+//a 0 after the last run ends the list, 200 bytes of SRAM for all ten
+#ifndef FONT_NO_CACHE
+GAME_LOCAL uint8_t font_digit_runs[10][FONT_RUNS];
+#endif
+GAME_LOCAL uint16_t font_digit_fg;
+GAME_LOCAL uint16_t font_digit_bg;
+
+//expands 0-9 in the given colors, returns the most runs any digit took
+//without the cache it only keeps the colors and counts the runs
+uint8_t font_cache_digits(uint16_t fg, uint16_t bg){
+    uint8_t most = 0;
+    font_digit_fg = fg;
+    font_digit_bg = bg;
+    for (uint8_t d = 0; d < 10; d++){
+        const uint8_t *glyph = font_glyph('0' + d);
+        uint8_t n = 0;
+        bool ink = false;
+#ifndef FONT_NO_CACHE
+        uint8_t *runs = font_digit_runs[d];
+        runs[0] = 0;
+#endif
+        for (uint8_t r = 0; r < FONT_ROWS; r++){
+            for (uint8_t c = 0; c < FONT_COLS; c++){
+                if (font_pixel(glyph, c, r) != ink){
+                    ink = !ink;
+                    n++;
+#ifndef FONT_NO_CACHE
+                    if (n < FONT_RUNS){
+                        runs[n] = 0;
+                    }
+#endif
+                }
+#ifndef FONT_NO_CACHE
+                if (n < FONT_RUNS){
+                    runs[n]++;
+                }
+#endif
+            }
+        }
+        n++;
+#ifndef FONT_NO_CACHE
+        if (n < FONT_RUNS){
+            runs[n] = 0;
+        }
+#endif
+        most = (n > most) ? n : most;
+    }
+    return most;
+}
+
+//one cached digit with its lowest left pixel at (x, y), FONT_COLS x FONT_ROWS, no spacing column
+void DrawDigit(uint8_t d, uint8_t x, uint8_t y){
+    struct pixel_stream px;
+    px.half = false;
+
+    SetWriteWindow(x, y, x + FONT_COLS - 1, y + FONT_ROWS - 1);
+    TRACE_BEGIN(TRACE_SPI);
+    PORTB &= ~PIN_SS;   // CS LOW
+    PORTB |= A0;        // DC HIGH (data mode)
+#ifdef FONT_NO_CACHE
+    const uint8_t *glyph = font_glyph('0' + d);
+    uint16_t fg = font_digit_fg;
+    uint16_t bg = font_digit_bg;
+#ifdef TFT_COLOR_444
+    fg = TFT_444(fg);
+    bg = TFT_444(bg);
+#endif
+    for (uint8_t r = 0; r < FONT_ROWS; r++){
+        for (uint8_t c = 0; c < FONT_COLS; c++){
+            StreamPut(&px, font_pixel(glyph, c, r) ? fg : bg);
+        }
+    }
+#else
+    const uint8_t *runs = font_digit_runs[d];
+    for (uint8_t i = 0; i < FONT_RUNS && (i == 0 || runs[i] != 0); i++){
+        StreamRun(&px, runs[i], (i & 1) ? font_digit_fg : font_digit_bg);
+    }
+#endif
+    StreamEnd(&px);
+    SPI_DESELECT();     // CS HIGH
+    TRACE_END(TRACE_SPI);
+}
+
+#endif /* FONT_H */
@@ -0,0 +1,1395 @@
+#ifndef GAME_H
+#define GAME_H
+
+//GAME CORE
+//everything between the drivers and main(): shared state, level generation, rendering,
+//the six state machines and the task table
+//hardware is only reached through the driver headers and the AVR register set, so a
+//native build (HOST_BUILD) runs the same code against the emulated peripherals in host/
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include "periph.h"
+#include "sound.h"
+#include "helper.h"
+#include "timerISR.h"
+#include "serialATmega.h"
+#include "spiAVR.h"
+#include "EEPROM.h"
+#include "LCD.h"
+#include "remote.h"
+#include "stackPaint.h"
+#include "eventTrace.h"
+#include "snapshot.h"
+#include "deadline.h"
+#include "gameConfig.h"
+#include "sprite.h"
+#include "font.h"
+#include "shadowFB.h"
+#include "rleImage.h"
+#include "assets.h"
+
+#define RED 0x001F
+#define GREEN 0x07E0
+#define WHITE 0xFFFF  
+#define BLK 0x0000
+
+#define BACKGROUND WHITE
+#define PLAYER_COLOR BLK
+#define PIPE_COLOR BLK
+#ifdef SHADOW_FB
+static_assert(BACKGROUND == SHADOW_PAPER && PIPE_COLOR == SHADOW_INK && PLAYER_COLOR == SHADOW_INK,
+              "the shadow framebuffer holds two colors, background and ink");
+#endif
+
+//physics for TickPosition
+#ifndef FALL_ACCEL
+#define FALL_ACCEL 1 //acceleration downwards 
+#endif
+#ifndef JUMP_VERTICAL
+#define JUMP_VERTICAL 3 //how high we ascend each tick of JUMPING  
+#endif
+#ifndef JUMP_HANGTIME
+#define JUMP_HANGTIME 5 //how many ticks to ascend by vertical  
+#endif
+#ifndef START_HEIGHT
+#define START_HEIGHT 64 //where we start each time a new game is played 
+#endif
+
+//scroll speed for TickLevel, columns a tick in 8.8 fixed point, 256 is one column
+#ifndef SCROLL_RAMP
+#define SCROLL_RAMP 0 //added for each point scored, 0 keeps the original one column a tick
+#endif
+#ifndef SCROLL_MAX
+#define SCROLL_MAX 1024 //where the ramp stops, 4 columns a tick
+#endif
+
+//headless host runs skip the SPI traffic, the game logic inside TickDraw still runs
+//with SHADOW_FB TickDeath reads what TickDraw drew, so it always draws and the host panel drops the pixels
+#if defined(HOST_BUILD) && !defined(SHADOW_FB)
+  #define DRAW_ENABLED() host_render
+#else
+  #define DRAW_ENABLED() true
+#endif
+
+
+
+//CROSS-TASK COMMUNICATION 
+
+  //SET BY TickButtons
+  GAME_LOCAL bool control; //USED BY TickMenu 
+  GAME_LOCAL bool jump; //USED BY TickPosition 
+
+  //SET BY TickMenu
+  enum GAME_STATE {PAUSE, PLAY, RESET};
+  GAME_LOCAL enum GAME_STATE game_state; //USED BY TickPosition, TickScreen/Game, TickBuzzer 
+  GAME_LOCAL bool snapshot_wanted = false; //a pause asked for a snapshot, USED BY TimerISR
+
+  //SET BY TickPosition
+  GAME_LOCAL int height = 64; //USED BY TickDeath
+  //TickPosition's own counters, kept out here so a snapshot can restore them
+  GAME_LOCAL unsigned int position_cnt = 0;
+  GAME_LOCAL unsigned int position_speed = 0;
+
+  //SET BY TickDeath
+  GAME_LOCAL bool dead = false; //USED BY TickMenu
+  //TickDeath's own last check in PLAY, the start of the next swept test, -1 when there is none
+  GAME_LOCAL int death_frame = -1;
+  GAME_LOCAL int death_height = 0;
+  
+  //SET BY TickLevel 
+  GAME_LOCAL struct column* curr_column; //USED BY TickDeath
+  GAME_LOCAL int score = 0; //SET TO 0 in TickDeath, USED BY TickScoreboard
+  //track which frame we are on 
+  GAME_LOCAL int frame; 
+  GAME_LOCAL int level_pos = 0; //TickLevel's i, the frame the next tick shows
+  GAME_LOCAL uint8_t level_sub = 0; //fraction of a column TickLevel has moved past level_pos, 1/256ths
+  GAME_LOCAL uint8_t level_step = 0; //whole columns the last tick moved
+  GAME_LOCAL uint8_t scroll_ramp = SCROLL_RAMP; //the difficulty, host_sim scroll sets it at run time
+
+  //SET BY TickScoreboard, SET TO score in TickDeath
+  GAME_LOCAL int high_score = EEPROM_read(EEPROM_SCORE_ADDR); //load in from EEPOM on intialization
+
+  //SET BY TimerISR, scheduler cycles since boot, USED BY remote events
+  GAME_LOCAL unsigned long tick_count = 0;
+
+
+
+//LEVEL CREATION LOGIC 
+
+  struct column {
+    //check collision, increment score, draw if there is a pipe 
+    bool has_pipe = false;
+    //standard gap size between top and bottom column, use for collision check
+    //the same for every column, so it is not stored in each one, 2 bytes a column
+    static constexpr uint8_t gap = GAP;
+    int8_t bottom = -1; //top = bottom + gap
+  };
+
+  GAME_LOCAL struct column columns[LEVEL_SIZE]; 
+
+  void create_level(){
+    int max = GAP_MAX;
+    int min = GAP_MIN; 
+    int range = max - min + 1;
+
+    for (int i = 0; i < LEVEL_SIZE; i++){
+      //if column is a pipe, randomly generate a bottom height, then fill the rest of columns within pipe_width
+      if (layout::pipe_column(i)){
+        columns[i].has_pipe = true;
+        columns[i].bottom = rng_next() % range + min;
+      }
+
+      else if (i == 0){
+        columns[i].has_pipe = false;
+      }
+
+      else {
+        columns[i].has_pipe = false;
+        columns[i].bottom = - 1;
+      }
+    }
+  }
+
+  //allows us to change a pipe's value off screen
+  void refresh_pipe(int i){
+    int max = GAP_MAX;
+    int min = GAP_MIN; 
+    int range = max - min + 1;
+
+    columns[i - PLAYER_OFFSET].has_pipe = true;
+    columns[i - PLAYER_OFFSET].bottom = rng_next() % range + min;
+  }
+
+
+
+//SPRITES
+//2bpp bird that fills the box TickDeath checks, BIRD_W columns by BIRD_H rows,
+//11x5 for the classic box and 13x7 for game_bigbird's, rows lowest first: clear, body, eye, beak
+//glide while falling, up and down alternate through a jump. the SHADOW_FB test is the drawn mask
+#define BIRD_W (PLAYER_SIZE + 1)
+#define BIRD_H (2*(PLAYER_SIZE/4) + 1) //height - PLAYER_SIZE/4 to height + PLAYER_SIZE/4
+#define BIRD_X (PLAYER_OFFSET - BIRD_W/2) //the sprite's left column
+static_assert(PLAYER_SIZE == 10 || PLAYER_SIZE == 12, "the bird is drawn for a box of 10 or 12, add frames for another");
+  const uint8_t bird_glide[] PROGMEM = {11, 5, 2,
+    0x01, 0x50, 0x00, 0x15, 0x55, 0x40, 0x55, 0x55, 0x7C, 0x15, 0x56, 0x40, 0x01, 0x54, 0x00};
+  const uint8_t bird_up[] PROGMEM = {11, 5, 2,
+    0x00, 0x50, 0x00, 0x05, 0x55, 0x40, 0x15, 0x55, 0x7C, 0x05, 0x56, 0x40, 0x14, 0x55, 0x00};
+  const uint8_t bird_down[] PROGMEM = {11, 5, 2,
+    0x50, 0x14, 0x00, 0x15, 0x55, 0x40, 0x15, 0x55, 0x7C, 0x05, 0x56, 0x40, 0x01, 0x54, 0x00};
+  const uint8_t bird_big_glide[] PROGMEM = {13, 7, 2,
+    0x00, 0x55, 0x00, 0x00, 0x05, 0x55, 0x50, 0x00, 0x15, 0x55, 0x54, 0x00, 0x55, 0x55, 0x57, 0xC0,
+    0x15, 0x55, 0x64, 0x00, 0x05, 0x55, 0x50, 0x00, 0x00, 0x55, 0x00, 0x00};
+  const uint8_t bird_big_up[] PROGMEM = {13, 7, 2,
+    0x00, 0x15, 0x00, 0x00, 0x01, 0x55, 0x50, 0x00, 0x05, 0x55, 0x54, 0x00, 0x15, 0x55, 0x57, 0xC0,
+    0x05, 0x55, 0x64, 0x00, 0x15, 0x15, 0x50, 0x00, 0x50, 0x15, 0x40, 0x00};
+  const uint8_t bird_big_down[] PROGMEM = {13, 7, 2,
+    0x50, 0x01, 0x40, 0x00, 0x15, 0x15, 0x50, 0x00, 0x05, 0x55, 0x54, 0x00, 0x15, 0x55, 0x57, 0xC0,
+    0x05, 0x55, 0x64, 0x00, 0x01, 0x55, 0x50, 0x00, 0x00, 0x15, 0x00, 0x00};
+  const uint16_t bird_palette[4] PROGMEM = {BACKGROUND, PLAYER_COLOR, WHITE, RED};
+
+//1bpp lip at the open end of each pipe, one column either side of it, the clear column on the
+//right wipes where the lip was the frame before
+  const uint8_t pipe_cap[] PROGMEM = {4, 2, 1, 0xE0, 0xE0};
+  const uint16_t pipe_palette[2] PROGMEM = {BACKGROUND, PIPE_COLOR};
+#define PIPE_CAP_LEFT 1 //cap columns left of the pipe
+
+  //the frame draw_player shows and TickDeath tests, wings move while TickPosition counts hangtime
+  //PLAYER_SIZE is a constant, the other set folds away
+  const uint8_t *bird_sprite() {
+    if (PLAYER_SIZE == 12) {
+      return (position_cnt == 0) ? bird_big_glide : (position_cnt & 1) ? bird_big_up : bird_big_down;
+    }
+    return (position_cnt == 0) ? bird_glide : (position_cnt & 1) ? bird_up : bird_down;
+  }
+
+
+//HUD
+//score top right and best top left, on the TFT in the top HUD_ROWS rows. the pipes stop under them
+//and the bird's columns stay clear of both, so nothing else draws there
+//a digit is only sent when it changed, from the cache font.h fills at boot
+//-DNO_HUD leaves the whole panel to the game, -DNO_LCD drops the 16x2 scoreboard
+#ifndef NO_HUD
+#define HUD_ROWS (FONT_ROWS + 2)
+#else
+#define HUD_ROWS 0
+#endif
+#define PIPE_TOP (YE - HUD_ROWS) //highest row a pipe is drawn on
+#define HUD_Y (YE - FONT_ROWS)
+#define HUD_SCORE_DIGITS 5
+#define HUD_BEST_DIGITS 4    //right of them is the bird
+#define HUD_SLOTS (HUD_SCORE_DIGITS + HUD_BEST_DIGITS)
+static_assert(1 + HUD_BEST_DIGITS * FONT_PITCH <= PLAYER_OFFSET - PLAYER_SIZE/2, "best runs into the bird");
+static_assert(GAP_MAX + GAP + 2 <= PIPE_TOP, "the highest gap's upper cap runs into the HUD");
+
+  GAME_LOCAL int hud_value[2];           //score, best, as write_score got them
+  GAME_LOCAL char hud_shown[HUD_SLOTS];  //what each slot shows, 0 once the panel was drawn over
+
+  void hud_init() {
+    font_cache_digits(PIPE_COLOR, BACKGROUND);
+  }
+
+  void hud_invalidate() {
+    memset(hud_shown, 0, sizeof(hud_shown));
+  }
+
+  //one number right aligned in digits slots from slot, clamped to what fits
+  void hud_number(int value, uint8_t slot, uint8_t digits, uint8_t x) {
+    int max = 1;
+    for (uint8_t i = 0; i < digits; i++) {
+      max *= 10;
+    }
+    value = (value < 0) ? 0 : (value >= max) ? max - 1 : value;
+
+    for (int8_t i = digits - 1; i >= 0; i--) {
+      char ch = (i == digits - 1 || value > 0) ? '0' + value % 10 : ' ';
+      value /= 10;
+      uint8_t dx = x + i * FONT_PITCH;
+      if (hud_shown[slot + i] != ch) {
+        if (ch == ' ') {
+          SetWriteWindow(dx, HUD_Y, dx + FONT_COLS - 1, YE - 1);
+          FillWindow(dx, HUD_Y, dx + FONT_COLS - 1, YE - 1, BACKGROUND);
+        }
+        else {
+          DrawDigit(ch - '0', dx, HUD_Y);
+        }
+        hud_shown[slot + i] = ch;
+      }
+    }
+  }
+
+  void hud_draw() {
+#ifndef NO_HUD
+    hud_number(hud_value[0], 0, HUD_SCORE_DIGITS, XE - HUD_SCORE_DIGITS * FONT_PITCH + 1);
+    hud_number(hud_value[1], HUD_SCORE_DIGITS, HUD_BEST_DIGITS, 1);
+#endif
+  }
+
+
+//PERIPHIALS 
+  void write_score(int write_score, int line){
+    hud_value[line] = write_score;
+#ifndef NO_LCD
+    char buf[12];
+    int len = 0;
+    
+    // Convert number to string
+    itoa(write_score, buf, 10);
+    
+    // Calculate string length
+    while(buf[len] != '\0') {
+      len++;
+    }
+    
+    // Position cursor at right-aligned position
+    // Assuming 16 characters per line, start at (16 - length)
+    lcd_goto_xy(line, 16 - len);
+    
+    // Write the entire string
+    for (int i = 0; i < len; i++) {
+      lcd_write_character(buf[i]);
+    }
+#endif
+  }
+
+  //the LCD's fixed labels, in flash, boot.h queues the same ones
+  const char scoreboard_score[] PROGMEM = "Score:";
+  const char scoreboard_best[] PROGMEM = "Best:";
+
+  void scoreboard_init(){
+    //read from EEPROM here for the highscore 
+    //highscore = eeprom_read_word((uint16_t*)0);
+    
+#ifndef NO_LCD
+    lcd_clear();
+    lcd_goto_xy(0, 0);
+    lcd_write_P(scoreboard_score);
+#endif
+    write_score(score, 0);
+    
+#ifndef NO_LCD
+    lcd_goto_xy(1, 0);
+    lcd_write_P(scoreboard_best);
+#endif
+    write_score(high_score, 1);
+  }
+
+  void draw_player() {
+
+    static GAME_LOCAL int last_height = -1; // initialize to an invalid value
+    static GAME_LOCAL const uint8_t *last_sprite = NULL;
+
+    uint8_t x0 = PLAYER_OFFSET - PLAYER_SIZE/2;
+    uint8_t x1 = PLAYER_OFFSET + PLAYER_SIZE/2;
+
+    // Paused and unchanged, nothing around it moves either (loadShed.h)
+    if (shed_level > 0 && game_state == PAUSE && height == last_height && bird_sprite() == last_sprite) {
+      shed_skipped++;
+      return;
+    }
+
+    // Erase previous player position
+    if (last_height >= PLAYER_SIZE/2) {
+        uint8_t y0_old = last_height - PLAYER_SIZE/2;
+        uint8_t y1_old = last_height + PLAYER_SIZE/2;
+        DrawRect(x0, y0_old, x1, y1_old, BACKGROUND); // erase with white
+    }
+
+
+    // Draw new player position
+    if (height >= PLAYER_SIZE/4) {
+      DrawSprite(bird_sprite(), BIRD_X, height - PLAYER_SIZE/4, bird_palette);
+    }
+
+
+    last_height = height;
+    last_sprite = bird_sprite();
+  }
+
+  void paint_pipe(column pipe, int x_pos) {
+    // Draw bottom pipe
+    DrawRect(x_pos, YS, x_pos, pipe.bottom, PIPE_COLOR); // draw with black
+
+    // Draw top pipe
+    DrawRect(x_pos, pipe.bottom + pipe.gap, x_pos, PIPE_TOP, PIPE_COLOR); // draw with black
+
+    // Caps on both ends of the gap, clipped at the screen edges
+    DrawSprite(pipe_cap, x_pos - PIPE_CAP_LEFT, pipe.bottom - 1, pipe_palette);
+    DrawSprite(pipe_cap, x_pos - PIPE_CAP_LEFT, pipe.bottom + pipe.gap, pipe_palette);
+  }
+
+  void draw_pipe(column pipe, int x_pos) {
+
+    uint8_t x0 = x_pos;
+    uint8_t x1 = x_pos;
+    uint8_t y0;
+    uint8_t y1;
+
+    // Wipe bottom pipe
+    y0 = YS;
+    y1 = pipe.bottom;
+    DrawRect(x0+1, y0, x1+1, y1, BACKGROUND); 
+
+    // Wipe top pipe
+    y0 = pipe.bottom + pipe.gap;
+    y1 = PIPE_TOP;
+    DrawRect(x0+1, y0, x1+1, y1, BACKGROUND); 
+
+    paint_pipe(pipe, x_pos);
+  }
+
+//PIPE MOVES UNDER LOAD
+//with the stride above 1 a far pipe jumps several columns at once (loadShed.h), so does every
+//pipe above one column a tick (SCROLL SPEED). draw_pipe only wipes the column it just left, so
+//wipe_pipe clears what the last draw left where it was instead, with the bottom it had then,
+//refresh_pipe may have moved it since
+#define SHED_PIPES (LEVEL_SIZE / PIPE_SPACING) //one pipe in each PIPE_SPACING
+#define SHED_NEAR (PLAYER_OFFSET + PLAYER_SIZE/2 + PIPE_CAP_LEFT + 1) //pipes at or left of this draw every tick
+
+  GAME_LOCAL int16_t pipe_drawn_x[SHED_PIPES];      //column the pipe was last drawn at, -1 if not on the panel
+  GAME_LOCAL int8_t pipe_drawn_bottom[SHED_PIPES];
+
+  void pipes_forget() {
+      for (uint8_t k = 0; k < SHED_PIPES; k++) {
+          pipe_drawn_x[k] = -1;
+      }
+  }
+
+  void wipe_pipe(column pipe, int x_pos) {
+    uint8_t cap_x0 = (x_pos > PIPE_CAP_LEFT) ? x_pos - PIPE_CAP_LEFT : 0;
+    uint8_t cap_x1 = x_pos - PIPE_CAP_LEFT + pgm_read_byte(pipe_cap) - 1;
+    uint8_t cap_h = pgm_read_byte(pipe_cap + 1);
+
+    DrawRect(x_pos, YS, x_pos, pipe.bottom, BACKGROUND);
+    DrawRect(x_pos, pipe.bottom + pipe.gap, x_pos, PIPE_TOP, BACKGROUND);
+    DrawRect(cap_x0, pipe.bottom - 1, cap_x1, pipe.bottom - 2 + cap_h, BACKGROUND);
+    DrawRect(cap_x0, pipe.bottom + pipe.gap, cap_x1, pipe.bottom + pipe.gap + cap_h - 1, BACKGROUND);
+  }
+
+  //where column i's pipe is on the panel, -1 while it is off it
+  int pipe_screen_pos(int i) {
+    int pos = i - frame + PLAYER_OFFSET;
+    pos = (pos < 0) ? pos + LEVEL_SIZE : pos;
+    return (pos >= 0 && pos < LEVEL_SIZE) ? pos : -1;
+  }
+
+  void draw_pipes() {
+    // Only draw pipes that are in view
+    for (int i = 0; i < LEVEL_SIZE; i++) {
+      if (columns[i].has_pipe && (i & layout::spacing_mask) < PIPE_WIDTH - 1) {
+
+        uint8_t k = i / PIPE_SPACING;
+        int pos = pipe_screen_pos(i);
+        int old = pipe_drawn_x[k];
+        column was = columns[i];
+        was.bottom = pipe_drawn_bottom[k];
+
+        // Unchanged since the last draw, only worth redrawing at full load
+        if (shed_level > 0 && pos >= 0 && pos == old) {
+          shed_skipped++;
+          continue;
+        }
+        // Far pipes take turns, the ones by the bird always move
+        if (pos > SHED_NEAR && !shed_due(k, tick_count)) {
+          shed_deferred++;
+          continue;
+        }
+
+        // Left through column 0, the renderer leaves the last draw there, anywhere else it goes
+        if (old >= 0 && (pos < 0 || pos > old)) {
+          if (old > 0) {
+            wipe_pipe(was, old);
+          }
+          old = -1;
+        }
+
+        // A jump of more than one column, or refresh_pipe moved the gap under it
+        if (pos >= 0) {
+          if (old >= 0 && (old - pos > 1 || was.bottom != columns[i].bottom)) {
+            wipe_pipe(was, old);
+            paint_pipe(columns[i], pos);
+          }
+          else {
+            draw_pipe(columns[i], pos);
+          }
+          pipe_drawn_bottom[k] = columns[i].bottom;
+        }
+        pipe_drawn_x[k] = pos;
+      }
+
+    }
+  }
+
+  void FillBackground(int background = BACKGROUND) {
+      // Fill the full screen window with white using macros
+      DrawRect(XS, YS, XE, YE, background);
+  }
+
+//SCREEN TRANSITIONS
+//full screen redraws run DRAW_BUDGET pixels a tick, so a reset never stalls the scheduler and the
+//buttons and menu keep their 100 ms. a pixel is roughly 40 cycles on the SPI bus, 2048 of them
+//are about 80k cycles, 5 ms of the tick
+//  title   the backdrop art, then a card in the middle, splash at boot and game over after. both
+//          stream lowest row first, so the title wipes in from the bottom
+//  fade    back to the flat playfield in BAND_ROWS passes, each pass clears one row of every band
+//the playfield stays flat BACKGROUND, every eraser in draw_player and draw_pipe relies on it
+#ifndef DRAW_BUDGET
+#define DRAW_BUDGET 2048
+#endif
+#define BAND_ROWS 8
+#define BAND_COUNT ((YE - YS + BAND_ROWS) / BAND_ROWS)
+
+  GAME_LOCAL struct image_stream title_image; //the backdrop, then the card
+  GAME_LOCAL const uint8_t *title_card;       //NULL once the card has started
+  GAME_LOCAL bool title_done = false;
+  GAME_LOCAL int fade_step = 0;               //rows the fade has walked, some fall past YE
+  GAME_LOCAL bool fade_done = false;
+
+  void title_begin(const uint8_t *card) {
+      title_card = card;
+      title_done = false;
+      shadow_reset(false); //no stale pipes for TickDeath, nothing on the panel to skip against
+      hud_invalidate();
+      pipes_forget();
+      image_begin(&title_image, asset_background, XS, YS);
+  }
+
+  //one tick of the title, returns true once the card is up
+  bool title_continue() {
+      uint16_t budget = shed_budget(DRAW_BUDGET);
+      while (budget > 0) {
+          uint16_t before = title_image.left;
+          uint16_t left = image_continue(&title_image, budget);
+          budget -= before - left;
+          if (left > 0) {
+              return false;
+          }
+          if (title_card == NULL) {
+              return true;
+          }
+          uint8_t w = pgm_read_byte(title_card);
+          uint8_t h = pgm_read_byte(title_card + 1);
+          image_begin(&title_image, title_card, (XE + 1 - w) / 2, (YE + 1 - h) / 2);
+          title_card = NULL;
+      }
+      return false;
+  }
+
+  void fade_begin() {
+      fade_step = 0;
+      fade_done = false;
+  }
+
+  //one tick of the fade, returns true once every row is BACKGROUND
+  bool fade_continue() {
+      uint16_t budget = shed_budget(DRAW_BUDGET);
+      while (fade_step < BAND_ROWS * BAND_COUNT && budget >= XE - XS + 1) {
+          uint8_t y = YS + (fade_step % BAND_COUNT) * BAND_ROWS + fade_step / BAND_COUNT;
+          fade_step++;
+          if (y <= YE) {
+              DrawRect(XS, y, XE, y, BACKGROUND);
+              budget -= XE - XS + 1;
+          }
+      }
+      if (fade_step < BAND_ROWS * BAND_COUNT) {
+          return false;
+      }
+      shadow_validate(); //every row went through the mirror since title_begin
+      return true;
+  }
+
+  GAME_LOCAL bool panel_inverted = false;
+
+  //the panel command, every tick at full load and only on a change once shedding
+  void panel_invert(bool on) {
+      if (shed_level > 0 && on == panel_inverted) {
+        shed_skipped++;
+        return;
+      }
+      SendCommand(on ? INVERT : REVERT);
+      panel_inverted = on;
+  }
+
+  //the bird and pipes for this tick, inverted while paused
+  void draw_frame() {
+      shed_frames[shed_level]++;
+      if(game_state == PAUSE){
+        panel_invert(true);
+        draw_player();
+        draw_pipes();
+      }
+      else { 
+        draw_player();
+        draw_pipes();
+        panel_invert(false);
+      }
+  }
+
+
+
+//STATES AND TASKS 
+enum DRAW_STATES{SETUP, DRAW, TITLE, WIPING, CLEARING};
+int TickDraw(int state){
+
+  static GAME_LOCAL bool splashed = false; //the splash card only shows at boot
+
+  switch(state){
+    case(SETUP):
+      if (DRAW_ENABLED()){
+        SendCommand(REVERT);
+        panel_inverted = false;
+      }
+      title_begin(splashed ? asset_gameover : asset_splash);
+      splashed = true;
+      create_level();
+      state = WIPING;
+      break;
+
+    case(WIPING):
+    case(TITLE):
+      //the title stays up through the pause, the playfield fades back in from the first PLAY tick
+      if (game_state == RESET){
+        state = SETUP;
+      }
+      else if (game_state == PLAY){
+        fade_begin();
+        state = CLEARING;
+      }
+      else {
+        state = title_done ? TITLE : WIPING;
+      }
+      break;
+
+    case(CLEARING):
+      if (game_state == RESET){
+        state = SETUP;
+      }
+      else {
+        state = fade_done ? DRAW : CLEARING;
+      }
+      break;
+
+    case(DRAW):
+      state = (game_state != RESET) ? DRAW : SETUP;
+      break;
+  }
+  switch(state){
+    case(SETUP):
+    case(TITLE):
+      break;
+
+    case(WIPING):
+      title_done = !DRAW_ENABLED() || title_continue();
+      break;
+
+    case(CLEARING):
+      //the game is already running, it draws over the rows the fade has not reached yet
+      fade_done = !DRAW_ENABLED() || fade_continue();
+      if (DRAW_ENABLED()){
+        draw_frame();
+      }
+      break;
+
+    case(DRAW):
+
+      if (!DRAW_ENABLED()){
+        break;
+      }
+
+      draw_frame();
+      hud_draw(); //after the fade, it would clear the digits
+      break;
+  }
+  return state;
+}
+
+enum BUTTON_STATE {IDLE, SET_CONTROL, SET_JUMP};
+//button levels for PC0/PC1, remote mode can stand in for the physical buttons
+//replay can stand in for both, and records whatever was sampled
+unsigned char read_buttons(){
+  return replay_buttons(tick_count, remote_buttons(PINC));
+}
+
+int TickButtons(int state){
+  unsigned char buttons = read_buttons(); //sample once so every transition sees the same levels
+
+  //transitions 
+  switch(state){
+    case(IDLE): 
+      //transition + set flag for both buttons on push
+      //left button is for control 
+      if (GetBit(buttons, 0) && !GetBit(buttons,1)){
+        control = true;
+        state = SET_CONTROL;
+      }
+      //right button is for jump
+      else if (GetBit(buttons, 1) && !GetBit(buttons, 0) ){
+        jump = true;
+        state = SET_JUMP;
+      }
+
+      break;
+
+    case(SET_CONTROL):
+      if (GetBit(buttons, 0)){
+        state = SET_CONTROL;
+      }
+      else {
+        state = IDLE;
+      }
+
+      break;
+
+    case(SET_JUMP):
+      if (GetBit(buttons, 1)){
+        state = SET_JUMP;
+        jump = false; //you only jump once per push, turn off on the first self loop so we jump one tick 
+      }
+      else {
+        state = IDLE;
+      }
+
+      break;
+  }
+
+  //state actions  
+  switch(state){
+    case(IDLE): 
+      control = false;
+      jump = false; 
+      break;
+
+    case(SET_CONTROL):
+      control = true; //redundant to show behavior 
+      break;
+
+    case(SET_JUMP):
+      break;
+  }
+
+  return state;
+
+}
+
+enum MENU_STATE {PAUSED, HOLDING_PLAY_RESET, PLAYING, RESETTING, HOLDING_PAUSED};
+int TickMenu(int state){
+
+  static GAME_LOCAL int cnt = 0; //control hold timer for reset 
+  static int reset_timer = 30; // = ? this is how long we will hold in pause to reset the game 
+
+
+  //transitions 
+  switch(state){
+    case(PAUSED):
+      if (control){
+        state = HOLDING_PLAY_RESET;
+      }
+      else {
+        state = PAUSED;
+      }
+      break;
+
+    case(HOLDING_PLAY_RESET):
+      if (control && cnt < reset_timer){
+        state = HOLDING_PLAY_RESET;
+
+      }
+
+      else if (!control && cnt < reset_timer){
+        cnt = 0;
+        state = PLAYING;
+        //the run moves on, a power loss from here starts a new game
+        snapshot_wanted = false;
+        snapshot_erase();
+      }
+
+      else if (cnt == reset_timer){
+        cnt = 0;
+        state = RESETTING;
+      }
+      break;
+
+    case(PLAYING):
+      if (!control){
+        state = (dead) ? RESETTING : PLAYING;
+        if (dead){
+          sound_play(SOUND_DEATH);
+        }
+      }
+
+      else { 
+        game_state = PAUSE;
+        state = HOLDING_PAUSED;
+        snapshot_wanted = true;
+        sound_play(SOUND_PAUSE);
+      }
+      break;
+
+    case(RESETTING):
+      state = HOLDING_PAUSED;
+      game_state = PAUSE;
+      break;
+
+    case(HOLDING_PAUSED):
+      if (control){
+        state = HOLDING_PAUSED;
+      }
+      else {
+        state = PAUSED;
+      }
+      break;
+  }
+
+  //remote reset/seed lands from any state, so does a recording at its longest
+  if (remote_take_reset(tick_count)){
+    cnt = 0;
+    state = RESETTING;
+  }
+
+  //state actions 
+  switch(state){
+    case(PAUSED):
+      game_state = PAUSE;
+      break;
+
+    case(HOLDING_PLAY_RESET):
+      cnt++;
+      break;
+
+    case(PLAYING):
+      game_state = PLAY;
+      break;
+
+    case(RESETTING):
+      game_state = PLAY;
+      dead = false;
+      game_state = RESET;
+      curr_column = &columns[0];
+
+      //TickDraw regenerates the level on RESET, seed it first so scripted runs repeat
+      if (remote_seeded){
+        rng_seed(remote_seed);
+        remote_seeded = false;
+      }
+      replay_reset(tick_count, score, height); //closes the last trace, a replay reseeds from its trace
+      snapshot_wanted = false;
+      snapshot_erase();
+
+      if (score > high_score){
+        high_score = score - 1;
+        write_score(high_score, 1);
+        EEPROM_write_score(EEPROM_SCORE_ADDR, high_score);
+      }
+      score = 0;
+
+      scoreboard_init();
+
+      break;
+
+    case(HOLDING_PAUSED):
+      break;
+  }
+
+
+  return state;
+}
+
+enum POSITION_STATES {FALLING, JUMPING, FREEZE, RESTART};
+int TickPosition(int state){
+
+  //TODO TUNE THESE USING SERIAL MONITOR AND DISPLAY DIMENSIONS 
+  unsigned int &cnt = position_cnt;
+  unsigned int &speed = position_speed; //how much position is changing each tick of FALLING
+  const unsigned int accel = FALL_ACCEL; //acceleration downwards 
+  const unsigned int vertical = JUMP_VERTICAL; //how high we ascend each tick of JUMPING  
+  const unsigned int hangtime = JUMP_HANGTIME; //how many ticks to ascend by vertical  
+  const unsigned int start_height = START_HEIGHT; //where we start each time a new game is played 
+  const unsigned int start_speed = 0; //we start not moving then we accelerate downwards 
+  
+  //transitions 
+  switch(state){
+    case(FALLING):
+      if (jump && game_state != RESET && game_state != PAUSE){
+        state = JUMPING;
+        sound_play(SOUND_JUMP);
+      }
+      else if (game_state == RESET){
+        height = start_height;
+        speed = start_speed;
+        state = RESTART; 
+      }
+
+      else if (game_state == PAUSE){
+        state = FREEZE;
+      }
+
+      else {
+        state = FALLING;
+      }
+      break;
+
+    case(JUMPING):
+      if (cnt < hangtime && game_state != RESET && game_state != PAUSE && !dead){
+        state = JUMPING;
+        cnt = jump ? 0 : cnt; //reset count if we press jump during a jump
+        if (jump){
+          sound_play(SOUND_JUMP);
+        }
+      }
+
+      else if (cnt == hangtime && game_state != RESET){
+        speed = start_speed; 
+        cnt = 0;
+        state = FALLING;
+      }
+
+      else if(game_state == PAUSE){
+        state = FREEZE;
+      }
+
+      else if (game_state == RESET){
+        height = start_height;
+        speed = start_speed;
+        state = RESTART;
+        cnt = 0;
+      }
+      break;
+
+    case(FREEZE):
+      if(game_state == PLAY){
+        //if we were mid jump, then cnt > 0, then we should continue our jump 
+        state = (cnt != 0) ? JUMPING : FALLING; 
+      }
+
+      else if (game_state == PAUSE){
+        state = FREEZE;
+      }
+
+      else if (game_state == RESET){
+        state = RESTART;
+      }
+      break;
+
+    case(RESTART):
+      height = start_height;
+      speed = start_speed;
+      state = FREEZE;
+      break;
+  }
+
+  //state actions 
+  switch(state){
+    case(FALLING):
+      speed += accel;
+      height -= speed; 
+      break;
+
+    case(JUMPING):
+      cnt++;      
+      height += vertical;
+      break;
+
+    case(FREEZE):
+      break;
+
+    case(RESTART): 
+      break;
+  }
+
+
+  return state;
+
+}
+
+//SCROLL SPEED
+//one column a tick, plus scroll_ramp 256ths of one for each point scored, up to SCROLL_MAX.
+//TickLevel moves the whole columns one at a time, so every score and refresh_pipe column it
+//passes still fires, and carries the fraction in level_sub
+//draw_pipes already moves a pipe several columns in one go, it wipes where the pipe was drawn
+//and paints where it is, the columns in between are never touched. TickDeath checks a window
+//PLAYER_SIZE + 1 columns wide, a step no wider puts every pipe inside it on some tick, so the
+//bird cannot pass one between two checks
+#define SCROLL_BASE 256
+static_assert(SCROLL_MAX >= SCROLL_BASE, "the ramp starts at one column a tick");
+static_assert((SCROLL_MAX + 255) / 256 <= PLAYER_SIZE + 1, "a pipe could jump the collision window in one tick");
+
+uint16_t scroll_speed(){
+  unsigned long speed = SCROLL_BASE + (unsigned long)scroll_ramp * score;
+  return (speed > SCROLL_MAX) ? SCROLL_MAX : speed;
+}
+
+enum LEVEL_STATES {STOP, GO};
+int TickLevel(int state){
+  int &i = level_pos;
+  frame = i;
+  level_step = 0;
+  //transitions and state actions together
+  switch(state){
+    case(STOP):
+      //only state action is keeping i at 0
+      if (game_state == PLAY){
+        state = GO;
+      }
+      else {
+        i = (game_state == RESET) ? 0 : i;
+        level_sub = (game_state == RESET) ? 0 : level_sub;
+        state = STOP;
+      }
+      break;
+
+    case(GO):
+      if (game_state == PLAY){
+        uint16_t sub = level_sub + scroll_speed();
+        level_sub = sub & 0xFF;
+        level_step = sub >> 8;
+
+        for (uint8_t step = 0; step < level_step; step++){
+          //change the heights of just passed pipe for the next revolution
+          //moment a pipe is off screen, refresh its value 
+
+          if (layout::score_column(i)){
+            write_score(score, 0);
+            score++;
+            sound_play(SOUND_SCORE);
+          }
+          //i can be offset, but only if we draw pipes as they come
+          if (layout::refresh_column(i)){
+            refresh_pipe(i);
+          }
+
+          i = layout::wrap(i + 1);
+        }
+
+      }
+      else {
+        i = (game_state == RESET) ? 0 : i;
+        level_sub = (game_state == RESET) ? 0 : level_sub;
+        state = STOP;
+      }
+      break;
+  }
+
+  curr_column = &columns[i];
+  return state;
+}
+
+//SWEPT COLLISION
+//TickDeath sees the bird once a tick. between two checks it went in a straight line from
+//(death_frame, death_height) to (frame, height), and a gap is one interval, so the bird clears a
+//pipe over a stretch of that line if it clears it at both ends. the stretch is where the pipe is
+//inside the bird's PLAYER_SIZE + 1 columns, an end at the last check was tested by it already
+//at one column a tick every stretch ends at this check and the test is the box test TickDeath
+//always made, host_sim swept checks that for every case. faster, a pipe can come into or leave
+//the window between two checks, the other end of its stretch catches the bird clipping the lip
+//positions along the line are in 1/s of a column, s the columns between the checks, so the
+//test stays in integers, two compares an end and at most two ends for the one pipe in reach
+
+  //bird at h/s against the pipe in c, the box test
+  inline bool pipe_hits(const column &c, int h, int s) {
+    return h - layout::box_below * s < c.bottom * s || (c.bottom + c.gap) * s < h + layout::box_above * s;
+  }
+
+  //the bird went from (f0, h0) to (f1, h1) since the last check, f0 -1 if there was none
+  bool swept_hits(int f0, int h0, int f1, int h1) {
+    int s = (f1 < f0) ? f1 - f0 + LEVEL_SIZE : f1 - f0;
+    //no last check, as if it came from one column back at this height, the plain box test
+    if (f0 < 0 || s == 0 || s > PLAYER_SIZE + 1) {
+      s = 1;
+      h0 = h1;
+    }
+    int dh = h1 - h0;
+    h0 *= s;
+    for (int d = -layout::reach - s + 1; d < layout::reach + 1; d++) {
+      const column &c = columns[layout::wrap(f1 + d)];
+      if (!c.has_pipe) {
+        continue;
+      }
+      //columns past f0 where the window reaches the pipe, first and last
+      int n0 = d + s - layout::reach;
+      int n1 = d + s + layout::reach;
+      n1 = (n1 > s) ? s : n1;
+      if (pipe_hits(c, h0 + dh * n1, s) || (n0 > 0 && pipe_hits(c, h0 + dh * n0, s))) {
+        return true;
+      }
+    }
+    return false;
+  }
+
+enum DEATH_STATES{CHECK};
+int TickDeath (int state){
+  //hit ground or ceiling
+  if (height < 0 || 128 < height){
+    dead = true; 
+    height = 64;
+  }
+
+#ifdef SHADOW_FB
+  //pixel exact, the bird's mask against the pipes the last TickDraw left in the shadow framebuffer
+  //TickLevel has not moved the frame yet, so they are where this frame's check expects them
+  else {
+    //the pipes run on under the HUD, a bird above PIPE_TOP is tested against the row below it
+    int16_t y = height - PLAYER_SIZE/4;
+    int16_t y_max = PIPE_TOP + 1 - BIRD_H;
+    y = (y > y_max) ? y_max : y;
+    dead = shadow_hits(bird_sprite(), BIRD_X, y);
+  }
+#else
+  //intersection with current column
+  else if (curr_column->has_pipe && (height <  curr_column->bottom || (curr_column->bottom + curr_column->gap) < height)){
+    dead = true; 
+  }
+
+  else {
+    //every column the bird's box went over since the last check
+    dead = swept_hits((game_state == PLAY) ? death_frame : -1, death_height, frame, height);
+  }
+#endif
+
+  death_frame = (game_state == PLAY) ? frame : -1;
+  death_height = height;
+
+  return state;
+}
+
+
+//TASK SCHEDULING 
+  
+  // Task struct for concurrent synchSMs implmentations
+  typedef struct _task{
+    unsigned int state; 		//Task's current state
+    unsigned long period; 		//Task period
+    unsigned long elapsedTime; 	//Time elapsed since last task tick
+    int (*TickFct)(int); 		//Task tick function
+  } task;
+
+  //TASK_PERIODS
+  const unsigned long TASK1_PERIOD = 100;
+  const unsigned long TASK2_PERIOD = 100;
+
+  const unsigned long GCD_PERIOD = findGCD(TASK1_PERIOD, TASK2_PERIOD);
+
+  #define NUM_TASKS 6 /*number of task here*/
+  GAME_LOCAL task tasks[NUM_TASKS]; // declared task array with 5 tasks (2 in exercise 1)
+  #define TASK_POSITION 1
+  #define TASK_MENU 3
+  #define TASK_LEVEL 4
+  #define TASK_DRAW 5
+
+
+
+//SNAPSHOT
+//the paused game as a snapshot.h payload, level counters, bird, score, PRNG and the pipes
+//
+//PAYLOAD LAYOUT (little endian)
+//  [0..2]   LEVEL_SIZE, PIPE_SPACING, GAP, a build with other tunables ignores the snapshot
+//  [3]      level_pos
+//  [4]      frame
+//  [5..6]   height
+//  [7..8]   position_speed
+//  [9]      position_cnt
+//  [10..11] score
+//  [12..15] rng_state
+//  [16]     level_sub
+//  [17]     pipe count, then a (column, bottom) pair per pipe
+//
+//a paused game is taken once TickPosition has frozen, the tick after the pause at most, so
+//nothing in the payload moves until play resumes
+
+  #define SNAPSHOT_FIXED 18
+
+  int snapshot_pack(uint8_t *buf){
+    int n = 0;
+    buf[n++] = LEVEL_SIZE & 0xFF;
+    buf[n++] = PIPE_SPACING;
+    buf[n++] = GAP;
+    buf[n++] = level_pos;
+    buf[n++] = frame;
+    buf[n++] = height & 0xFF;
+    buf[n++] = (height >> 8) & 0xFF;
+    buf[n++] = position_speed & 0xFF;
+    buf[n++] = (position_speed >> 8) & 0xFF;
+    buf[n++] = position_cnt;
+    buf[n++] = score & 0xFF;
+    buf[n++] = (score >> 8) & 0xFF;
+    for (int b = 0; b < 4; b++){
+      buf[n++] = (rng_state >> (8 * b)) & 0xFF;
+    }
+    buf[n++] = level_sub;
+    int count_at = n++;
+    buf[count_at] = 0;
+    for (int c = 0; c < LEVEL_SIZE; c++){
+      if (columns[c].has_pipe){
+        if (n + 2 > SNAPSHOT_PAYLOAD_MAX){
+          return 0; //more pipes than a record holds, no snapshot
+        }
+        buf[n++] = c;
+        buf[n++] = columns[c].bottom;
+        buf[count_at]++;
+      }
+    }
+    return n;
+  }
+
+  //checks the whole payload before touching any state
+  bool snapshot_unpack(const uint8_t *buf, int len){
+    if (len < SNAPSHOT_FIXED || buf[0] != (LEVEL_SIZE & 0xFF) || buf[1] != PIPE_SPACING || buf[2] != GAP){
+      return false;
+    }
+    int pipes = buf[17];
+    if (len != SNAPSHOT_FIXED + 2 * pipes || buf[3] >= LEVEL_SIZE || buf[4] >= LEVEL_SIZE){
+      return false;
+    }
+    for (int p = 0; p < pipes; p++){
+      if (buf[SNAPSHOT_FIXED + 2 * p] >= LEVEL_SIZE){
+        return false;
+      }
+    }
+
+    level_pos = buf[3];
+    frame = buf[4];
+    height = (int16_t)(buf[5] | (buf[6] << 8));
+    position_speed = buf[7] | (buf[8] << 8);
+    position_cnt = buf[9];
+    score = (int16_t)(buf[10] | (buf[11] << 8));
+    rng_state = 0;
+    for (int b = 0; b < 4; b++){
+      rng_state |= (unsigned long)buf[12 + b] << (8 * b);
+    }
+    level_sub = buf[16];
+    for (int c = 0; c < LEVEL_SIZE; c++){
+      columns[c].has_pipe = false;
+      columns[c].bottom = -1;
+    }
+    for (int p = 0; p < pipes; p++){
+      struct column *col = &columns[buf[SNAPSHOT_FIXED + 2 * p]];
+      col->has_pipe = true;
+      col->bottom = buf[SNAPSHOT_FIXED + 2 * p + 1];
+    }
+    return true;
+  }
+
+  //called after the task loop, starts the background write once the pause has settled
+  void snapshot_check(){
+    if (snapshot_wanted && game_state == PAUSE && tasks[TASK_POSITION].state == FREEZE){
+      uint8_t buf[SNAPSHOT_PAYLOAD_MAX];
+      int len = snapshot_pack(buf);
+      if (len > 0){
+        snapshot_write(buf, len);
+      }
+      snapshot_wanted = false;
+    }
+    snapshot_poll();
+  }
+
+  //a valid payload puts every task straight on the paused screen, TickDraw skips SETUP so
+  //the level is not regenerated
+  bool snapshot_enter(const uint8_t *buf, int len){
+    if (len < 0 || !snapshot_unpack(buf, len)){
+      return false;
+    }
+    game_state = PAUSE;
+    dead = false;
+    curr_column = &columns[level_pos];
+    tasks[TASK_POSITION].state = FREEZE;
+    tasks[TASK_MENU].state = PAUSED;
+    tasks[TASK_LEVEL].state = STOP;
+    tasks[TASK_DRAW].state = DRAW;
+    return true;
+  }
+
+  //called once from main() after tasks_init(), in place of create_level()
+  bool snapshot_resume(){
+    uint8_t buf[SNAPSHOT_PAYLOAD_MAX];
+    int len = snapshot_read(buf, SNAPSHOT_PAYLOAD_MAX);
+    return snapshot_enter(buf, len);
+  }
+
+  //every DEADLINE_KEEP healthy cycles the game as it stands goes into the .noinit record (deadline.h)
+  //a run that is over has nothing worth coming back to
+  void deadline_keep(){
+    if (tick_count % DEADLINE_KEEP != 0 && game_state != RESET){
+      return;
+    }
+    int len = (game_state == RESET) ? 0 : snapshot_pack((uint8_t *)deadline_rec.game);
+    deadline_seal(len);
+  }
+
+  //called from main() before snapshot_resume(), after a watchdog reset reports what hung and
+  //puts the game from the last healthy cycle on its paused screen
+  bool deadline_resume(){
+    if (!deadline_tripped()){
+      return false;
+    }
+    uint8_t buf[SNAPSHOT_PAYLOAD_MAX];
+    int len = deadline_report() ? deadline_game() : -1;
+    for (int i = 0; i < len; i++){
+      buf[i] = deadline_rec.game[i];
+    }
+    bool resumed = snapshot_enter(buf, len);
+    serial_println_P(resumed ? PSTR("W resumed") : PSTR("W lost"));
+    return resumed;
+  }
+
+
+  //TASK WINDOW
+  //the tasks run with the global interrupt flag back on and every source but Timer0 masked, so
+  //the sound ISR (sound.h) nests inside a long draw tick instead of losing its edges. Timer2's
+  //compare, UART RX and EEPROM ready keep their flags and run once the window closes, as they
+  //did when the whole cycle ran with interrupts off. a task that cancels the snapshot write
+  //leaves EERIE off
+  #define WINDOW_TIMER 0x01
+  #define WINDOW_RX 0x02
+  #define WINDOW_EEPROM 0x04
+  GAME_LOCAL uint8_t window_held = 0; //the sources task_window_open masked
+
+  inline void task_window_open(){
+    window_held = 0;
+    if (TIMSK2 & (1 << OCIE2A)){
+      window_held |= WINDOW_TIMER;
+      TIMSK2 &= ~(1 << OCIE2A);
+    }
+    if (UCSR0B & (1 << RXCIE0)){
+      window_held |= WINDOW_RX;
+      UCSR0B &= ~(1 << RXCIE0);
+    }
+    if (EECR & (1 << EERIE)){
+      window_held |= WINDOW_EEPROM;
+      EECR &= ~(1 << EERIE);
+    }
+    sei();
+  }
+
+  inline void task_window_close(){
+    cli();
+    if (window_held & WINDOW_TIMER){
+      TIMSK2 |= (1 << OCIE2A);
+    }
+    if (window_held & WINDOW_RX){
+      UCSR0B |= (1 << RXCIE0);
+    }
+    if ((window_held & WINDOW_EEPROM) && snapshot_busy()){
+      EECR |= (1 << EERIE);
+    }
+  }
+
+  void TimerISR() {
+
+    uint16_t started = CLOCK_NOW(); //the cycle's length sets the load shedding level, see loadShed.h
+    deadline_begin(tick_count + 1); //what the watchdog reports if this cycle never ends, see deadline.h
+    TRACE_BEGIN(TRACE_SCHED);
+    uint8_t *top = stack_task_begin(); //every call below is measured from here, see stackPaint.h
+    remote_poll(tick_count + 1); //the tick read_buttons sees below, an event for tick t reaches TickButtons at t
+    stack_task_end(STACK_SCHED, top);
+    if (remote_hold){
+      deadline_leave();
+      TRACE_END(TRACE_SCHED);
+      return; //host asked us to hold, time stands still for every task
+    }
+    tick_count++;
+
+    task_window_open();
+    for ( unsigned int i = 0; i < NUM_TASKS; i++ ) {                   // Iterate through each task in the task array
+      if ( tasks[i].elapsedTime == tasks[i].period ) {           // Check if the task is ready to tick
+        deadline_enter(i, tick_count);
+        TRACE_BEGIN(TRACE_TASK + i);
+        tasks[i].state = tasks[i].TickFct(tasks[i].state); // Tick and set the next state for this task
+        TRACE_END(TRACE_TASK + i);
+        tasks[i].elapsedTime = 0;                          // Reset the elapsed time for the next tick
+        stack_task_end(i, top);
+      }
+      tasks[i].elapsedTime += GCD_PERIOD;                        // Increment the elapsed time by GCD_PERIOD
+    }
+    task_window_close();
+    deadline_enter(DEADLINE_SCHED, tick_count);
+    snapshot_check();
+    stack_task_end(STACK_SCHED, top);
+    shed_cycle(CLOCK_NOW() - started, GCD_PERIOD);
+    deadline_keep();
+    deadline_leave();
+    TRACE_END(TRACE_SCHED);
+  }
+
+  //task table shared by main() and the host runner
+  void tasks_init(){
+    curr_column = &columns[0]; //TickDeath reads it before TickLevel's first tick sets it
+    hud_init();
+    pipes_forget();
+
+    int j = 0;
+    tasks[j].period = TASK1_PERIOD;
+    tasks[j].state = IDLE;
+    tasks[j].elapsedTime = 0;
+    tasks[j].TickFct = &TickButtons;
+
+    j++;
+    tasks[j].period = TASK1_PERIOD;
+    tasks[j].state = RESTART;
+    tasks[j].elapsedTime = 0;
+    tasks[j].TickFct = &TickPosition;
+
+    j++;
+    tasks[j].period = TASK1_PERIOD;
+    tasks[j].state = CHECK;
+    tasks[j].elapsedTime = 0;
+    tasks[j].TickFct = &TickDeath;
+
+    j++;
+    tasks[j].period = TASK1_PERIOD;
+    tasks[j].state = PAUSED;
+    tasks[j].elapsedTime = 0;
+    tasks[j].TickFct = &TickMenu;
+
+    j++;
+    tasks[j].period = TASK1_PERIOD;
+    tasks[j].state = STOP;
+    tasks[j].elapsedTime = 0;
+    tasks[j].TickFct = &TickLevel;
+
+    j++;
+    tasks[j].period = TASK2_PERIOD;
+    tasks[j].state = SETUP;
+    tasks[j].elapsedTime = 0;
+    tasks[j].TickFct = &TickDraw;
+  }
+
+#endif /* GAME_H */
@@ -0,0 +1,121 @@
+#ifndef GAMECONFIG_H
+#define GAMECONFIG_H
+
+//GAME CONFIGURATION
+//the level and bird geometry as one constexpr game_config, and game_layout, everything the tick
+//functions work out from it, folded at compile time. a variant is another game_config, picked
+//with -DGAME_CONFIG=game_easy (env:easy, env:hard, env:bigbird), nothing of it is left at run time
+//
+//  game_classic   the original game, built from the tunables below
+//  game_easy      wider gaps over a narrower range of bottoms
+//  game_hard      narrow gaps over the whole playfield
+//  game_bigbird   a bigger box and a 13x7 bird to fill it, gaps to match
+//
+//after the layout is picked LEVEL_SIZE, GAP and the rest name the picked variant's values, so the
+//drivers and host tools keep using the names they always did
+//
+//the level is a power of two so a column wraps with a mask, pipes are a power of two apart so the
+//pipe, score and refresh columns are a mask and a compare, the static_asserts in game_layout hold
+//every variant to what the tick functions assume
+
+//TUNABLES, each can be overridden from build_flags (-DGAP=28) for tuning runs, game_classic only
+#ifndef LEVEL_SIZE
+#define LEVEL_SIZE 128 //total unique frames to cycle through
+#endif
+#ifndef PIPE_SPACING
+#define PIPE_SPACING 32 //space between each pipe, used in random generation of pipes
+#endif
+#ifndef PLAYER_OFFSET
+#define PLAYER_OFFSET 31//screen x axis offset for player to be on screen at
+#endif
+#ifndef PLAYER_SIZE
+#define PLAYER_SIZE 10
+#endif
+#ifndef PIPE_WIDTH
+#define PIPE_WIDTH 16
+#endif
+#ifndef GAP
+#define GAP 32
+#endif
+#ifndef GAP_MIN
+#define GAP_MIN 10 //lowest pipe bottom create_level picks
+#endif
+#ifndef GAP_MAX
+#define GAP_MAX 86 //highest pipe bottom create_level picks
+#endif
+
+struct game_config {
+    int level_size;
+    int pipe_spacing;
+    int player_offset;
+    int player_size;
+    int pipe_width;
+    int gap;
+    int gap_min;
+    int gap_max;
+};
+
+constexpr game_config game_classic = {LEVEL_SIZE, PIPE_SPACING, PLAYER_OFFSET, PLAYER_SIZE, PIPE_WIDTH, GAP, GAP_MIN, GAP_MAX};
+constexpr game_config game_easy = {128, 32, 31, 10, 16, 40, 14, 78};
+constexpr game_config game_hard = {128, 32, 31, 10, 16, 28, 10, 90};
+constexpr game_config game_bigbird = {128, 32, 31, 12, 16, 40, 12, 80};
+
+#ifndef GAME_CONFIG
+#define GAME_CONFIG game_classic
+#endif
+
+template <const game_config &C>
+struct game_layout {
+    static constexpr int level_size = C.level_size;
+    static constexpr int pipe_spacing = C.pipe_spacing;
+    static constexpr int player_offset = C.player_offset;
+    static constexpr int player_size = C.player_size;
+    static constexpr int pipe_width = C.pipe_width;
+    static constexpr int gap = C.gap;
+    static constexpr int gap_min = C.gap_min;
+    static constexpr int gap_max = C.gap_max;
+
+    static constexpr int level_mask = level_size - 1;
+    static constexpr int spacing_mask = pipe_spacing - 1;
+    static constexpr int reach = player_size / 2;     //columns the box reaches either side of frame
+    static constexpr int box_below = player_size / 4 - 1; //rows under height the box test spares
+    static constexpr int box_above = player_size / 4;
+
+    static_assert((level_size & level_mask) == 0, "LEVEL_SIZE must be a power of two, columns wrap with a mask");
+    static_assert((pipe_spacing & spacing_mask) == 0, "PIPE_SPACING must be a power of two");
+    static_assert(level_size % pipe_spacing == 0, "pipes must tile the level");
+    static_assert(level_size <= 256, "snapshot stores columns in one byte");
+    static_assert(((player_offset + 1) & spacing_mask) == 0, "refresh_pipe must land on a pipe column");
+    static_assert(reach < pipe_spacing / 2, "the collision window may only reach one pipe");
+    static_assert(player_offset >= reach && player_offset + reach < level_size, "the bird must be on the panel");
+    static_assert(gap_min >= 1 && gap_min <= gap_max, "the lower cap is drawn under the bottom");
+    static_assert(gap_max <= 127, "a bottom is an int8_t");
+
+    //column i of the level, any int, back into it
+    static constexpr int wrap(int i) { return i & level_mask; }
+    static constexpr bool pipe_column(int i) { return i != 0 && (i & spacing_mask) == 0; }
+    static constexpr bool score_column(int i) { return (i & spacing_mask) == 1; }
+    static constexpr bool refresh_column(int i) { return (i & spacing_mask) == spacing_mask; }
+};
+
+typedef game_layout<GAME_CONFIG> layout;
+
+//from here on the names are the picked variant's
+#undef LEVEL_SIZE
+#undef PIPE_SPACING
+#undef PLAYER_OFFSET
+#undef PLAYER_SIZE
+#undef PIPE_WIDTH
+#undef GAP
+#undef GAP_MIN
+#undef GAP_MAX
+#define LEVEL_SIZE (layout::level_size)
+#define PIPE_SPACING (layout::pipe_spacing)
+#define PLAYER_OFFSET (layout::player_offset)
+#define PLAYER_SIZE (layout::player_size)
+#define PIPE_WIDTH (layout::pipe_width)
+#define GAP (layout::gap)
+#define GAP_MIN (layout::gap_min)
+#define GAP_MAX (layout::gap_max)
+
+#endif /* GAMECONFIG_H */
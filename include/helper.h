@@ -6,6 +6,27 @@
 #ifndef HELPER_H
 #define HELPER_H
 
+//storage for mutable driver and game state, thread_local in the native build (host/host_hw.h)
+//so the host tools can run one independent game per thread, nothing on the AVR
+#ifndef GAME_LOCAL
+  #define GAME_LOCAL
+#endif
+
+//FEATURES_LEAN / FEATURES_RICH set the flags and buffer sizes the drivers below test
+#include "featureTiers.h"
+
+//FREE RUNNING CLOCK
+//Timer1 counts at /64 from boot_run on, 4 us a count, and wraps every 262 ms. intervals are a
+//subtraction of two reads, eventTrace.h stamps events with it, loadShed.h times the scheduler
+//cycle and snapshot.h its EEPROM writes. the native build counts emulated time plus the TFT bus,
+//host_bus_us_per_byte for every byte the panel took
+#define CLOCK_US_PER_COUNT 4
+#ifdef HOST_BUILD
+  #define CLOCK_NOW() ((uint16_t)((host_time_us + host_bus_us) / CLOCK_US_PER_COUNT))
+#else
+  #define CLOCK_NOW() TCNT1
+#endif
+
 //Functionality - finds the greatest common divisor of two values
 //Parameter: Two long int's to find their GCD
 //Returns: GCD else 0
@@ -41,4 +62,29 @@ return bFirst + (long((inVal - aFirst))*long((bSecond-bFirst)))/(aSecond -
 aFirst);
 }
 
+//Functionality - seedable PRNG, same Park-Miller generator as avr-libc rand()
+//state is ours so a run can be recorded, replayed and snapshotted from its seed
+GAME_LOCAL unsigned long rng_state = 1;
+
+void rng_seed(unsigned long seed){
+	rng_state = seed;
+}
+
+//Returns: 0 to 0x7FFF like rand(), advances the given state
+int rng_next_from(unsigned long *state){
+	long hi, lo, x;
+	x = *state;
+	if (x == 0) { x = 123459876L; }
+	hi = x / 127773L;
+	lo = x % 127773L;
+	x = 16807L * lo - 2836L * hi;
+	if (x < 0) { x += 0x7FFFFFFFL; }
+	*state = x;
+	return x % 0x8000UL;
+}
+
+int rng_next(){
+	return rng_next_from(&rng_state);
+}
+
 #endif /* HEPLER_H */
\ No newline at end of file
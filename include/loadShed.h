@@ -0,0 +1,106 @@
+#ifndef LOADSHED_H
+#define LOADSHED_H
+
+#include <avr/io.h>
+#include "helper.h"
+#include "serialATmega.h"
+
+//LOAD SHEDDING
+//the scheduler has no way to drop work, a TickDraw that runs past the 100 ms period makes every
+//task late. TimerISR times each cycle on CLOCK_NOW and hands it to shed_cycle, which moves the
+//renderer between levels. the simulation ticks the same at every level, only drawing changes
+//
+//  0  everything, every tick
+//  1  cosmetic work goes: pipes and the bird that have not moved are not redrawn, the
+//     INVERT/REVERT command is only sent when it changes, title and fade take half the budget
+//  2  pipes away from the bird draw every 2nd tick, two scroll steps in one move
+//  3  every 4th tick
+//  4  every 8th tick
+//
+//pipes from the bird's right edge down to column 0 draw every tick at every level, so the pipes
+//TickDeath can touch are always where the panel shows them. the far pipes take turns, pipe k
+//draws when (tick + k) is a multiple of the stride, so no tick moves them all at once
+//
+//a cycle over SHED_LIMIT goes up a level, SHED_RECOVER cycles in a row under half of it come
+//down one. a cycle over 262 ms wraps the clock and reads short
+//the remote 'o' command prints the counters, "O <name> <n>" lines then "O done"
+
+#define SHED_LEVELS 5
+#define SHED_RECOVER 10
+#define SHED_LIMIT(period_ms) ((uint16_t)((period_ms) * 750UL / CLOCK_US_PER_COUNT)) //75% of the period
+
+GAME_LOCAL uint8_t shed_level = 0;
+GAME_LOCAL uint8_t shed_calm = 0;          //cycles in a row under half the limit
+GAME_LOCAL bool shed_enabled = true;       //false holds level 0, host_sim stress compares both
+
+//counters, the 'o' report
+GAME_LOCAL unsigned long shed_frames[SHED_LEVELS]; //draw ticks at each level
+GAME_LOCAL unsigned long shed_overruns = 0;        //cycles longer than the period, the tasks slipped
+GAME_LOCAL unsigned long shed_deferred = 0;        //pipe moves put off to a later tick
+GAME_LOCAL unsigned long shed_skipped = 0;         //redraws of something that had not changed
+GAME_LOCAL uint16_t shed_worst = 0;                //longest cycle, clock counts
+
+//one scheduler cycle took counts, period_ms is the scheduler's
+void shed_cycle(uint16_t counts, unsigned long period_ms){
+    uint16_t limit = SHED_LIMIT(period_ms);
+    if (counts > shed_worst){
+        shed_worst = counts;
+    }
+    if (counts >= period_ms * 1000UL / CLOCK_US_PER_COUNT){
+        shed_overruns++;
+    }
+    if (!shed_enabled){
+        shed_level = 0;
+        return;
+    }
+    if (counts > limit){
+        if (shed_level < SHED_LEVELS - 1){
+            shed_level++;
+        }
+        shed_calm = 0;
+    }
+    else if (shed_level > 0 && counts < limit / 2){
+        if (++shed_calm >= SHED_RECOVER){
+            shed_level--;
+            shed_calm = 0;
+        }
+    }
+    else {
+        shed_calm = 0;
+    }
+}
+
+//ticks between two moves of a far pipe
+inline uint8_t shed_stride(){
+    return (shed_level < 2) ? 1 : 1 << (shed_level - 1);
+}
+
+//whether far pipe k moves this tick
+inline bool shed_due(uint8_t k, unsigned long tick){
+    return ((tick + k) & (shed_stride() - 1)) == 0;
+}
+
+//title and fade pixels a tick, the full budget down to a quarter
+inline uint16_t shed_budget(uint16_t budget){
+    return budget >> ((shed_level > 2) ? 2 : shed_level);
+}
+
+//name is in flash, index a digit after it or 0
+void shed_line(const char *name, unsigned long value, char index = 0){
+    serial_report_P('O', name, value, index);
+}
+
+//"O <name> <n>" lines for the remote 'o' command, then "O done"
+void shed_report(){
+    shed_line(PSTR("level"), shed_level);
+    for (uint8_t i = 0; i < SHED_LEVELS; i++){
+        shed_line(PSTR("frames"), shed_frames[i], '0' + i);
+    }
+    shed_line(PSTR("overruns"), shed_overruns);
+    shed_line(PSTR("deferred"), shed_deferred);
+    shed_line(PSTR("skipped"), shed_skipped);
+    shed_line(PSTR("worst_us"), (unsigned long)shed_worst * CLOCK_US_PER_COUNT);
+    serial_println_P(PSTR("O done"));
+}
+
+#endif /* LOADSHED_H */
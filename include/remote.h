@@ -0,0 +1,251 @@
+#ifndef REMOTE_H
+#define REMOTE_H
+
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <stdlib.h>
+#include "serialATmega.h"
+#include "replay.h"
+#include "stackPaint.h"
+#include "eventTrace.h"
+#include "loadShed.h"
+
+//UART RX command channel so a host script can stand in for the player
+//bytes are pulled in by the RX interrupt, commands are parsed once per scheduler cycle
+//remote mode turns on with the first button event and replaces PC0/PC1 until 'x'
+//
+//COMMANDS (one per line, '\n' or '\r' terminated)
+//  c<tick>,<0|1>   control button (PC0) goes up/down at scheduler tick
+//  j<tick>,<0|1>   jump button (PC1) goes up/down at scheduler tick
+//  p               hold, scheduler stops ticking tasks
+//  g               go, scheduler resumes
+//  r               reset the run
+//  s<seed>         seed the level generator and reset the run
+//  t               reply with the current scheduler tick
+//  x               leave remote mode, buttons come from PINC again
+//  w               record the next run (resets)
+//  v               replay the trace in RAM (resets)
+//  e / l           save the trace to / load it from EEPROM
+//  d               dump the trace as one line of hex
+//  m               report SRAM and stack high-water, "M <name> <bytes>" lines, see stackPaint.h
+//  f               dump the event trace ring as one line of hex, see eventTrace.h
+//  o               report the load shedding level and counters, "O <name> <n>" lines, see loadShed.h
+
+#ifndef REMOTE_RX_SIZE
+#define REMOTE_RX_SIZE 32 //power of two, wrap is a mask
+#endif
+#ifndef REMOTE_EVENT_SIZE
+#define REMOTE_EVENT_SIZE 16
+#endif
+
+static_assert((REMOTE_RX_SIZE & (REMOTE_RX_SIZE - 1)) == 0 && REMOTE_RX_SIZE <= 256, "REMOTE_RX_SIZE must be a power of two, the ring wraps with a mask");
+#define REMOTE_LINE_SIZE 16
+
+#if defined(USART0_RX_vect)
+  #define REMOTE_RX_vect USART0_RX_vect //ATmega1284
+#else
+  #define REMOTE_RX_vect USART_RX_vect //ATmega328P
+#endif
+
+struct remote_event {
+    unsigned long tick; //scheduler tick the edge happens on
+    unsigned char bit;  //0 = control, 1 = jump
+    unsigned char level;
+};
+
+GAME_LOCAL volatile unsigned char remote_rx[REMOTE_RX_SIZE];
+GAME_LOCAL volatile unsigned char remote_rx_head = 0; //written by the RX ISR
+GAME_LOCAL volatile unsigned char remote_rx_tail = 0; //written by remote_poll
+
+GAME_LOCAL struct remote_event remote_events[REMOTE_EVENT_SIZE];
+GAME_LOCAL unsigned char remote_event_head = 0;
+GAME_LOCAL unsigned char remote_event_count = 0;
+
+GAME_LOCAL char remote_line[REMOTE_LINE_SIZE];
+GAME_LOCAL unsigned char remote_line_len = 0;
+
+GAME_LOCAL bool remote_active = false;     //buttons come from remote_pins instead of PINC
+GAME_LOCAL bool remote_hold = false;       //scheduler skips tasks while set
+GAME_LOCAL bool remote_reset = false;      //consumed by TickMenu
+GAME_LOCAL bool remote_seeded = false;     //consumed by TickMenu on reset
+GAME_LOCAL unsigned long remote_seed = 0;
+GAME_LOCAL unsigned char remote_pins = 0;  //remote button levels, same bit layout as PINC
+
+
+void remote_init(){
+    if (SERIAL_LENT()){
+        return; //USART0 is the display bus, every byte it sends would clock one in
+    }
+    UCSR0B |= (1 << RXEN0) | (1 << RXCIE0); //serial_init leaves the RX interrupt off
+}
+
+ISR(REMOTE_RX_vect){
+    TRACE_MARK(TRACE_RX);
+    unsigned char next = (remote_rx_head + 1) & (REMOTE_RX_SIZE - 1);
+    unsigned char data = UDR0; //always read so the flag clears
+    if (next != remote_rx_tail){
+        remote_rx[remote_rx_head] = data;
+        remote_rx_head = next;
+    }
+    //full buffer drops the byte, the host paces itself with 't'
+}
+
+void remote_queue_event(unsigned long tick, unsigned char bit, unsigned char level){
+    if (remote_event_count == REMOTE_EVENT_SIZE){
+        serial_println_P(PSTR("E full"));
+        return;
+    }
+    unsigned char slot = (remote_event_head + remote_event_count) % REMOTE_EVENT_SIZE;
+    remote_events[slot].tick = tick;
+    remote_events[slot].bit = bit;
+    remote_events[slot].level = level;
+    remote_event_count++;
+    remote_active = true;
+}
+
+//parses "<tick>,<level>" after the command letter
+void remote_parse_event(unsigned char bit){
+    char *end;
+    unsigned long tick = strtoul(&remote_line[1], &end, 10);
+    if (*end != ','){
+        serial_println_P(PSTR("E syntax"));
+        return;
+    }
+    remote_queue_event(tick, bit, end[1] == '1');
+}
+
+void remote_dump_trace(){
+    unsigned int len = REPLAY_HEADER + replay_get16(&replay_trace[2]);
+    serial_char('T');
+    for (unsigned int i = 0; i < len; i++){
+        serial_hex(replay_trace[i] >> 4);
+        serial_hex(replay_trace[i]);
+    }
+    serial_char('\n');
+}
+
+void remote_run_line(unsigned long tick){
+    switch(remote_line[0]){
+        case('c'):
+            remote_parse_event(0);
+            break;
+
+        case('j'):
+            remote_parse_event(1);
+            break;
+
+        case('p'):
+            remote_hold = true;
+            break;
+
+        case('g'):
+            remote_hold = false;
+            break;
+
+        case('r'):
+            remote_reset = true;
+            break;
+
+        case('s'):
+            remote_seed = strtoul(&remote_line[1], NULL, 10);
+            remote_seeded = true;
+            remote_reset = true;
+            break;
+
+        case('t'):
+            serial_println((long)tick);
+            break;
+
+        case('w'):
+            replay_mode = REPLAY_ARM_RECORD;
+            remote_reset = true;
+            break;
+
+        case('v'):
+            if (replay_valid()){
+                replay_mode = REPLAY_ARM_PLAY;
+                remote_reset = true;
+            }
+            else {
+                serial_println_P(PSTR("E trace"));
+            }
+            break;
+
+        case('e'):
+            replay_save();
+            break;
+
+        case('l'):
+            if (!replay_load()){
+                serial_println_P(PSTR("E trace"));
+            }
+            break;
+
+        case('d'):
+            remote_dump_trace();
+            break;
+
+        case('f'):
+            trace_dump();
+            break;
+
+        case('m'):
+            stack_report();
+            break;
+
+        case('o'):
+            shed_report();
+            break;
+
+        case('x'):
+            remote_active = false;
+            remote_event_count = 0;
+            remote_pins = 0;
+            break;
+
+        default:
+            serial_println_P(PSTR("E cmd"));
+            break;
+    }
+}
+
+//called at the top of every scheduler cycle, drains the RX ring and applies due events
+//tick is the one this cycle's tasks run on, 't' replies with it
+void remote_poll(unsigned long tick){
+    while (remote_rx_tail != remote_rx_head){
+        char ch = remote_rx[remote_rx_tail];
+        remote_rx_tail = (remote_rx_tail + 1) & (REMOTE_RX_SIZE - 1);
+
+        if (ch == '\n' || ch == '\r'){
+            if (remote_line_len > 0){
+                remote_line[remote_line_len] = '\0';
+                remote_run_line(tick);
+            }
+            remote_line_len = 0;
+        }
+        else if (remote_line_len < REMOTE_LINE_SIZE - 1){
+            remote_line[remote_line_len++] = ch;
+        }
+    }
+
+    //events are expected in tick order, anything late is applied right away
+    while (remote_event_count > 0 && remote_events[remote_event_head].tick <= tick){
+        struct remote_event *ev = &remote_events[remote_event_head];
+        remote_pins = ev->level ? (remote_pins | (1 << ev->bit)) : (remote_pins & ~(1 << ev->bit));
+        remote_event_head = (remote_event_head + 1) % REMOTE_EVENT_SIZE;
+        remote_event_count--;
+    }
+}
+
+//button source for TickButtons, remote levels replace PC0/PC1 while remote mode is on
+unsigned char remote_buttons(unsigned char pins){
+    return remote_active ? (unsigned char)((pins & ~0x03) | remote_pins) : pins;
+}
+
+bool remote_take_reset(unsigned long tick){
+    bool reset = remote_reset || (replay_mode == REPLAY_PLAYING && replay_done) || replay_full(tick);
+    remote_reset = false;
+    return reset;
+}
+
+#endif /* REMOTE_H */
@@ -0,0 +1,245 @@
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include <stdint.h>
+#include "helper.h"
+#include "EEPROM.h"
+#include "serialATmega.h"
+
+//INPUT RECORD/REPLAY
+//a run is its PRNG seed plus the ticks where PC0/PC1 change level
+//recording starts on a reset and ends on the next one (death or manual reset)
+//
+//TRACE LAYOUT (little endian)
+//  [0]     REPLAY_MAGIC
+//  [1]     button levels at the start tick
+//  [2..3]  length of the event stream in bytes
+//  [4..7]  seed
+//  [8..9]  end tick, relative to the start tick
+//  [10..11] score at the end tick
+//  [12..13] height at the end tick
+//  [14..]  events
+//
+//EVENT: one byte, bits 0-1 are the new levels, bits 2-7 the tick delta since the last event
+//a delta of 63 or more writes 63 then (delta - 63) as a 7 bit per byte varint
+
+#define REPLAY_MAGIC 0xB1
+#define REPLAY_HEADER 14
+#ifndef REPLAY_SIZE
+#define REPLAY_SIZE 128 //event bytes, 64 press/release pairs with short gaps
+#endif
+#define REPLAY_ESCAPE 63
+#define REPLAY_MAX_TICKS 0xFFFF //the end tick is 16 bits, a recording this long is closed by a reset
+#define REPLAY_EEPROM_ADDR 0x000
+
+static_assert(REPLAY_EEPROM_ADDR + REPLAY_HEADER + REPLAY_SIZE <= 0x100, "the trace must end before the snapshot at 0x100");
+
+enum REPLAY_MODE {REPLAY_IDLE, REPLAY_ARM_RECORD, REPLAY_RECORDING, REPLAY_ARM_PLAY, REPLAY_PLAYING};
+GAME_LOCAL enum REPLAY_MODE replay_mode = REPLAY_IDLE;
+
+GAME_LOCAL uint8_t replay_trace[REPLAY_HEADER + REPLAY_SIZE];
+GAME_LOCAL uint16_t replay_len = 0;           //event bytes in replay_trace
+GAME_LOCAL bool replay_overflow = false;      //recording ran out of room, trace stops at the last event that fit
+
+GAME_LOCAL unsigned long replay_start_tick;   //scheduler tick of the reset that started the trace
+GAME_LOCAL unsigned long replay_event_tick;   //relative tick of the last event written/read
+GAME_LOCAL uint16_t replay_pos;               //read position while playing
+GAME_LOCAL bool replay_done = false;          //playback reached the recorded end tick, TickMenu resets
+GAME_LOCAL uint8_t replay_levels;             //levels after the last event
+GAME_LOCAL uint8_t replay_pins;               //last levels seen by read_buttons, kept in every mode
+
+
+void replay_put16(uint8_t *p, uint16_t v){
+    p[0] = v & 0xFF;
+    p[1] = v >> 8;
+}
+
+uint16_t replay_get16(const uint8_t *p){
+    return p[0] | ((uint16_t)p[1] << 8);
+}
+
+bool replay_valid(){
+    return replay_trace[0] == REPLAY_MAGIC && replay_get16(&replay_trace[2]) <= REPLAY_SIZE;
+}
+
+unsigned long replay_seed(){
+    const uint8_t *p = &replay_trace[4];
+    return p[0] | ((unsigned long)p[1] << 8) | ((unsigned long)p[2] << 16) | ((unsigned long)p[3] << 24);
+}
+
+bool replay_emit(uint8_t b){
+    if (replay_len == REPLAY_SIZE){
+        replay_overflow = true;
+        return false;
+    }
+    replay_trace[REPLAY_HEADER + replay_len++] = b;
+    return true;
+}
+
+void replay_record_start(unsigned long tick, unsigned long seed){
+    replay_trace[0] = 0; //stays invalid until the run ends
+    replay_trace[1] = replay_pins;
+    for (int i = 0; i < 4; i++){
+        replay_trace[4 + i] = (seed >> (8 * i)) & 0xFF;
+    }
+    replay_len = 0;
+    replay_overflow = false;
+    replay_start_tick = tick;
+    replay_event_tick = 0;
+    replay_levels = replay_pins;
+    replay_mode = REPLAY_RECORDING;
+}
+
+void replay_record(unsigned long tick, uint8_t levels){
+    if (levels == replay_levels || replay_overflow){
+        return;
+    }
+
+    unsigned long rel = tick - replay_start_tick;
+    unsigned long delta = rel - replay_event_tick;
+    uint16_t mark = replay_len; //roll back a half written event on overflow
+
+    if (delta < REPLAY_ESCAPE){
+        replay_emit((delta << 2) | levels);
+    }
+    else {
+        replay_emit((REPLAY_ESCAPE << 2) | levels);
+        delta -= REPLAY_ESCAPE;
+        do {
+            uint8_t b = delta & 0x7F;
+            delta >>= 7;
+            replay_emit(delta ? (b | 0x80) : b);
+        } while (delta);
+    }
+
+    if (replay_overflow){
+        replay_len = mark;
+        return;
+    }
+    replay_event_tick = rel;
+    replay_levels = levels;
+}
+
+//decodes the next event without consuming it, returns its relative tick or -1 at the end
+long replay_peek(uint16_t pos, uint16_t *next, uint8_t *levels){
+    uint16_t len = replay_get16(&replay_trace[2]);
+    if (pos >= len){
+        return -1;
+    }
+    const uint8_t *ev = &replay_trace[REPLAY_HEADER];
+    uint8_t b = ev[pos++];
+    unsigned long delta = b >> 2;
+    *levels = b & 0x03;
+
+    if (delta == REPLAY_ESCAPE){
+        uint8_t shift = 0;
+        unsigned long extra = 0;
+        while (pos < len){
+            uint8_t v = ev[pos++];
+            extra |= (unsigned long)(v & 0x7F) << shift;
+            shift += 7;
+            if (!(v & 0x80)){
+                break;
+            }
+        }
+        delta += extra;
+    }
+    *next = pos;
+    return replay_event_tick + delta;
+}
+
+void replay_play_start(unsigned long tick){
+    replay_start_tick = tick;
+    replay_event_tick = 0;
+    replay_pos = 0;
+    replay_done = false;
+    replay_levels = replay_trace[1];
+    replay_mode = REPLAY_PLAYING;
+}
+
+//a recording has reached the longest end tick the header holds, TickMenu resets on this tick
+//so the trace closes there instead of wrapping its end, about 1.8 hours at 100 ms a tick
+bool replay_full(unsigned long tick){
+    return replay_mode == REPLAY_RECORDING && tick - replay_start_tick >= REPLAY_MAX_TICKS;
+}
+
+//levels the trace holds at this tick, replaces PC0/PC1
+uint8_t replay_play(unsigned long tick){
+    unsigned long rel = tick - replay_start_tick;
+    uint16_t next;
+    uint8_t levels;
+    long at;
+    while ((at = replay_peek(replay_pos, &next, &levels)) >= 0 && (unsigned long)at <= rel){
+        replay_pos = next;
+        replay_event_tick = at;
+        replay_levels = levels;
+    }
+    //a recording cut short by a manual reset ends the replay on the same tick
+    replay_done = rel >= replay_get16(&replay_trace[8]);
+    return replay_levels;
+}
+
+//button hook for read_buttons, records or replaces the sampled levels
+unsigned char replay_buttons(unsigned long tick, unsigned char pins){
+    if (replay_mode == REPLAY_PLAYING){
+        pins = (pins & ~0x03) | replay_play(tick);
+    }
+    else if (replay_mode == REPLAY_RECORDING){
+        replay_record(tick, pins & 0x03);
+    }
+    replay_pins = pins & 0x03;
+    return pins;
+}
+
+//called from the RESETTING action with the score and height the run ended on
+//closes a running trace, then starts an armed one, a replay reseeds the PRNG from its trace
+void replay_reset(unsigned long tick, int score, int height){
+    unsigned long rel = tick - replay_start_tick;
+    uint16_t end = (rel > REPLAY_MAX_TICKS) ? REPLAY_MAX_TICKS : rel; //replay_full resets at the cap
+
+    if (replay_mode == REPLAY_RECORDING){
+        replay_trace[0] = REPLAY_MAGIC;
+        replay_put16(&replay_trace[2], replay_len);
+        replay_put16(&replay_trace[8], end);
+        replay_put16(&replay_trace[10], score);
+        replay_put16(&replay_trace[12], height);
+        replay_mode = REPLAY_IDLE;
+        serial_println_P(PSTR("R rec"));
+        serial_println((long)end);
+    }
+    else if (replay_mode == REPLAY_PLAYING){
+        replay_mode = REPLAY_IDLE;
+        if (end == replay_get16(&replay_trace[8]) && score == (int)replay_get16(&replay_trace[10])
+            && height == (int16_t)replay_get16(&replay_trace[12])){
+            serial_println_P(PSTR("R match"));
+        }
+        else {
+            serial_println_P(PSTR("R diverged"));
+        }
+        serial_println((long)end);
+    }
+
+    if (replay_mode == REPLAY_ARM_RECORD){
+        replay_record_start(tick, rng_state);
+    }
+    else if (replay_mode == REPLAY_ARM_PLAY){
+        replay_play_start(tick);
+        rng_seed(replay_seed());
+    }
+}
+
+void replay_save(){
+    EEPROM_write_block(REPLAY_EEPROM_ADDR, replay_trace, REPLAY_HEADER + replay_get16(&replay_trace[2]));
+}
+
+bool replay_load(){
+    EEPROM_read_block(REPLAY_EEPROM_ADDR, replay_trace, REPLAY_HEADER);
+    if (!replay_valid()){
+        replay_trace[0] = 0;
+        return false;
+    }
+    EEPROM_read_block(REPLAY_EEPROM_ADDR + REPLAY_HEADER, &replay_trace[REPLAY_HEADER], replay_get16(&replay_trace[2]));
+    return true;
+}
+
+#endif /* REPLAY_H */
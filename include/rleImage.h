@@ -0,0 +1,89 @@
+#ifndef RLEIMAGE_H
+#define RLEIMAGE_H
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "spiAVR.h"
+
+//RUN LENGTH IMAGES
+//full color art compiled from assets/*.png by scripts/asset_compiler.py into assets.h
+//runs are decoded straight into the RAMWR stream, there is no decode buffer
+//
+//IMAGE LAYOUT (PROGMEM bytes)
+//  [0] width   [1] height   [2] palette size n, at most 16
+//  [3..]       n palette words, little endian, in the panel's order like RED
+//  [3+2n..]    runs in stream order, rows lowest y first like sprite.h
+//              a run byte is (palette index << 4) | k
+//              k < 15    k + 1 pixels
+//              k == 15   16 + the next byte pixels, 16 to 271
+//
+//an image is drawn whole with DrawImage, or in pieces with image_begin/image_continue so a
+//big one can be spread over several ticks
+
+#define RLE_HEADER 3
+#define RLE_LONG 0x0F
+#define RLE_LONG_MIN 16
+
+struct image_stream {
+    const uint8_t *image;
+    const uint8_t *run;   //next run byte
+    uint16_t color;       //RGB565 of the current run
+    uint16_t run_left;    //pixels of the current run not sent yet
+    uint16_t left;        //pixels of the image not sent yet
+    struct pixel_stream px;
+};
+
+inline uint16_t image_pixels(const uint8_t *image){
+    return (uint16_t)pgm_read_byte(image) * pgm_read_byte(image + 1);
+}
+
+//sets the window for an image with its lowest left pixel at (x, y), it must fit on the panel
+void image_begin(struct image_stream *s, const uint8_t *image, uint8_t x, uint8_t y){
+    uint8_t w = pgm_read_byte(image);
+    uint8_t h = pgm_read_byte(image + 1);
+    s->image = image;
+    s->run = image + RLE_HEADER + 2 * pgm_read_byte(image + 2);
+    s->run_left = 0;
+    s->left = image_pixels(image);
+    s->px.half = false;
+    SetWriteWindow(x, y, x + w - 1, y + h - 1);
+}
+
+//streams up to budget more pixels, returns how many are still to go
+uint16_t image_continue(struct image_stream *s, uint16_t budget){
+    if (s->left == 0){
+        return 0;
+    }
+    TRACE_BEGIN(TRACE_SPI);
+    PORTB &= ~PIN_SS;   // CS LOW
+    PORTB |= A0;        // DC HIGH (data mode)
+
+    while (budget > 0 && s->left > 0){
+        if (s->run_left == 0){
+            uint8_t b = pgm_read_byte(s->run++);
+            uint8_t k = b & 0x0F;
+            s->run_left = (k == RLE_LONG) ? RLE_LONG_MIN + pgm_read_byte(s->run++) : k + 1;
+            s->color = pgm_read_word(s->image + RLE_HEADER + 2 * (b >> 4));
+        }
+        uint16_t n = (s->run_left < budget) ? s->run_left : budget;
+        StreamRun(&s->px, n, s->color);
+        s->run_left -= n;
+        s->left -= n;
+        budget -= n;
+    }
+    if (s->left == 0){
+        StreamEnd(&s->px);
+    }
+
+    SPI_DESELECT();     // CS HIGH
+    TRACE_END(TRACE_SPI);
+    return s->left;
+}
+
+void DrawImage(const uint8_t *image, uint8_t x, uint8_t y){
+    struct image_stream s;
+    image_begin(&s, image, x, y);
+    image_continue(&s, 0xFFFF);
+}
+
+#endif /* RLEIMAGE_H */
@@ -3,9 +3,21 @@
 
 #include <avr/io.h>
 #include <avr/interrupt.h>
+#include <avr/pgmspace.h>
+#include <avr/wdt.h>
 
 
+//a DISPLAY_BUS_MSPIM build hands USART0 to the TFT, the console stays quiet while it has it
+#ifdef DISPLAY_BUS_MSPIM
+  #define SERIAL_LENT() (UCSR0C & (1 << UMSEL01))
+#else
+  #define SERIAL_LENT() false
+#endif
+
 void serial_init (int baud ) {
+    if (SERIAL_LENT()){
+        return;
+    }
     UBRR0 = (((16000000/(baud*16UL)))-1) ; // Set baud rate
     UCSR0B |= (1 << TXEN0 ); 
     UCSR0B |= (1 << RXEN0 ); 
@@ -16,20 +28,52 @@ void serial_init (int baud ) {
 
 
 //sends a char
+//a byte is 1 ms at 9600 baud and a dump ('f', 'd') runs for over a second inside one cycle, every
+//byte the UART takes kicks the watchdog (deadline.h). a UART that stops taking them still trips it
 void serial_char(char ch )
 {
+    if (SERIAL_LENT()){
+        return;
+    }
     while (( UCSR0A & (1 << UDRE0 )) == 0);
+    wdt_reset();
     UDR0 = ch ;
 }
 
 //sends a string
-void serial_println(char *str){
-    for (int i; str[i] != '\0'; i++){
+void serial_println(const char *str){
+    for (int i = 0; str[i] != '\0'; i++){
         serial_char(str[i]);
     }
     serial_char('\n');
 }
 
+//FLASH STRINGS
+//a literal is copied into SRAM at boot and stays there, PSTR("...") leaves it in flash. every fixed
+//message and report name goes through the _P calls below, RAM strings (itoa buffers) still use
+//serial_println
+
+//sends a string from flash, PSTR("...") or a PROGMEM array, no newline
+void serial_print_P(const char *str){
+    char ch;
+    while ((ch = pgm_read_byte(str++)) != '\0'){
+        serial_char(ch);
+    }
+}
+
+//sends a string from flash and a newline
+void serial_println_P(const char *str){
+    serial_print_P(str);
+    serial_char('\n');
+}
+
+const char serial_hex_digits[] PROGMEM = "0123456789ABCDEF";
+
+//one hex digit, the low 4 bits of n
+inline void serial_hex(uint8_t n){
+    serial_char(pgm_read_byte(&serial_hex_digits[n & 0x0F]));
+}
+
 //sends an long. can be used with integers
 void serial_println(long num, int base = 10){
   char arr[sizeof(long)*8 + 1]; //array with size of largest possible number of digits for long
@@ -55,4 +99,17 @@ void serial_println(long num, int base = 10){
   serial_println(str);//print from str to end of arr
 }
 
+//"<kind> <name><index> <value>" report line, the 'm', 'o' and watchdog reports and avr_bench
+//name is in flash, index is a digit after it or 0 for none
+void serial_report_P(char kind, const char *name, unsigned long value, char index = 0){
+    serial_char(kind);
+    serial_char(' ');
+    serial_print_P(name);
+    if (index != 0){
+        serial_char(index);
+    }
+    serial_char(' ');
+    serial_println((long)value);
+}
+
 #endif
@@ -0,0 +1,191 @@
+#ifndef SHADOWFB_H
+#define SHADOWFB_H
+
+#include <stdint.h>
+#include <string.h>
+#include <avr/pgmspace.h>
+#include "helper.h"
+#include "spiAVR.h"
+#include "sprite.h"
+
+//SHADOW FRAMEBUFFER (SHADOW_FB)
+//a 1 bit mirror of the panel, set where SHADOW_INK was drawn, clear for SHADOW_PAPER
+//game.h draws through DrawRect and DrawSprite, which
+//  shrink a fill to the box of pixels that actually change and drop it if none do
+//  skip a sprite whose pixels are all already on the panel
+//  record what they wrote, so the mirror doubles as the pipe layer TickDeath tests the bird against
+//
+//132 rows of 17 bytes, 2244 bytes of SRAM, more than an uno has, built for the 1284 (env:shadow)
+//
+//the mirror only knows two colors, anything else stops the skipping until a full screen of known
+//pixels has gone through again (shadow_validate, or a full screen DrawRect)
+//a sprite with other colors (the bird) is not recorded, its box becomes the dirty box and every
+//fill inside it is sent whole. the bird is never in the mirror, the pipes under it are
+//
+//without SHADOW_FB DrawRect and DrawSprite are the plain SetWriteWindow/FillWindow and BlitSprite
+
+#ifndef SHADOW_PAPER
+#define SHADOW_PAPER 0xFFFF //game.h's BACKGROUND
+#endif
+#ifndef SHADOW_INK
+#define SHADOW_INK 0x0000   //game.h's PIPE_COLOR and PLAYER_COLOR
+#endif
+
+#define SHADOW_W (XE - XS + 1)
+#define SHADOW_H (YE - YS + 1)
+#define SHADOW_STRIDE ((SHADOW_W + 7) / 8)
+
+#ifdef SHADOW_FB
+
+GAME_LOCAL uint8_t shadow_fb[SHADOW_H][SHADOW_STRIDE];
+GAME_LOCAL bool shadow_valid = true;  //the mirror matches the panel, boot.h leaves it all paper
+GAME_LOCAL bool shadow_diff = true;   //skip unchanged pixels, the host turns it off to compare
+GAME_LOCAL int16_t shadow_dirty[4] = {1, 1, 0, 0}; //x0 y0 x1 y1 of the bird, empty at first
+
+inline bool shadow_get(uint8_t x, uint8_t y){
+    return shadow_fb[y][x >> 3] & (0x80 >> (x & 7));
+}
+
+inline void shadow_put(uint8_t x, uint8_t y, bool ink){
+    if (ink){
+        shadow_fb[y][x >> 3] |= 0x80 >> (x & 7);
+    }
+    else {
+        shadow_fb[y][x >> 3] &= ~(0x80 >> (x & 7));
+    }
+}
+
+inline bool shadow_is_dirty(uint8_t x, uint8_t y){
+    return x >= shadow_dirty[0] && y >= shadow_dirty[1] && x <= shadow_dirty[2] && y <= shadow_dirty[3];
+}
+
+//all paper, valid says whether the panel is all paper too
+void shadow_reset(bool valid){
+    memset(shadow_fb, 0, sizeof(shadow_fb));
+    shadow_valid = valid;
+}
+
+//every pixel has been drawn through the mirror since the last reset
+void shadow_validate(){
+    shadow_valid = true;
+}
+
+//true if any visible pixel of the sprite lands on ink
+bool shadow_hits(const uint8_t *sprite, int16_t x, int16_t y){
+    uint8_t w = pgm_read_byte(sprite);
+    uint8_t h = pgm_read_byte(sprite + 1);
+    uint8_t bpp = pgm_read_byte(sprite + 2);
+    uint8_t stride = (w * bpp + 7) / 8;
+    for (int16_t r = 0; r < h; r++){
+        for (int16_t c = 0; c < w; c++){
+            if (x + c < XS || x + c > XE || y + r < YS || y + r > YE){
+                continue;
+            }
+            if (sprite_value(sprite + SPRITE_HEADER + r * stride, c, bpp) != 0 && shadow_get(x + c, y + r)){
+                return true;
+            }
+        }
+    }
+    return false;
+}
+
+#else
+
+inline void shadow_reset(bool valid){}
+inline void shadow_validate(){}
+
+#endif
+
+//SetWriteWindow and FillWindow through the mirror
+void DrawRect(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint16_t color){
+#ifdef SHADOW_FB
+    bool known = color == SHADOW_PAPER || color == SHADOW_INK;
+    bool ink = color == SHADOW_INK;
+    uint8_t cx1 = (x1 > XE) ? XE : x1; //the mirror stops at the panel's edge
+    uint8_t cy1 = (y1 > YE) ? YE : y1;
+
+    if (shadow_valid && shadow_diff && known){
+        uint8_t bx0 = 0xFF, by0 = 0xFF, bx1 = 0, by1 = 0;
+        for (uint8_t y = y0; y <= cy1; y++){
+            for (uint8_t x = x0; x <= cx1; x++){
+                if (shadow_get(x, y) != ink || shadow_is_dirty(x, y)){
+                    bx0 = (x < bx0) ? x : bx0;
+                    bx1 = (x > bx1) ? x : bx1;
+                    by0 = (y < by0) ? y : by0;
+                    by1 = (y > by1) ? y : by1;
+                }
+            }
+        }
+        if (bx0 > bx1){
+            return;
+        }
+        x0 = bx0; y0 = by0; x1 = bx1; y1 = by1;
+        cx1 = x1; cy1 = y1;
+    }
+
+    for (uint8_t y = y0; y <= cy1; y++){
+        for (uint8_t x = x0; x <= cx1; x++){
+            shadow_put(x, y, ink);
+        }
+    }
+    if (!known){
+        shadow_valid = false;
+    }
+    else if (x0 == XS && y0 == YS && x1 >= XE && y1 >= YE){
+        shadow_valid = true;
+    }
+#endif
+    SetWriteWindow(x0, y0, x1, y1);
+    FillWindow(x0, y0, x1, y1, color);
+}
+
+//BlitSprite through the mirror
+void DrawSprite(const uint8_t *sprite, int16_t x, int16_t y, const uint16_t *palette){
+#ifdef SHADOW_FB
+    uint8_t w = pgm_read_byte(sprite);
+    uint8_t h = pgm_read_byte(sprite + 1);
+    uint8_t bpp = pgm_read_byte(sprite + 2);
+    uint8_t stride = (w * bpp + 7) / 8;
+    int16_t c0 = (x < XS) ? XS - x : 0;
+    int16_t c1 = (x + w - 1 > XE) ? XE - x : w - 1;
+    int16_t r0 = (y < YS) ? YS - y : 0;
+    int16_t r1 = (y + h - 1 > YE) ? YE - y : h - 1;
+    if (c0 > c1 || r0 > r1){
+        return;
+    }
+
+    bool known = true;
+    for (uint8_t v = 0; v < (1 << bpp); v++){
+        uint16_t c = pgm_read_word(&palette[v]);
+        known = known && (c == SHADOW_PAPER || c == SHADOW_INK);
+    }
+    if (!known){
+        shadow_dirty[0] = x + c0;
+        shadow_dirty[1] = y + r0;
+        shadow_dirty[2] = x + c1;
+        shadow_dirty[3] = y + r1;
+        BlitSprite(sprite, x, y, palette);
+        return;
+    }
+
+    //ink per sprite value, then compare and record the visible pixels
+    uint8_t ink_of = 0;
+    for (uint8_t v = 0; v < (1 << bpp); v++){
+        ink_of |= (pgm_read_word(&palette[v]) == SHADOW_INK) << v;
+    }
+    bool same = shadow_valid && shadow_diff;
+    for (int16_t r = r0; r <= r1; r++){
+        for (int16_t c = c0; c <= c1; c++){
+            bool ink = ink_of & (1 << sprite_value(sprite + SPRITE_HEADER + r * stride, c, bpp));
+            same = same && shadow_get(x + c, y + r) == ink && !shadow_is_dirty(x + c, y + r);
+            shadow_put(x + c, y + r, ink);
+        }
+    }
+    if (same){
+        return;
+    }
+#endif
+    BlitSprite(sprite, x, y, palette);
+}
+
+#endif /* SHADOWFB_H */
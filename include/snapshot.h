@@ -0,0 +1,171 @@
+#ifndef SNAPSHOT_H
+#define SNAPSHOT_H
+
+#include <stdint.h>
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include "helper.h"
+#include "EEPROM.h"
+#include "serialATmega.h"
+#include "eventTrace.h"
+
+//EEPROM SNAPSHOT RECORD
+//one versioned, CRC checked record the game state survives a power cycle in
+//the payload is opaque here, game.h packs and unpacks it
+//
+//RECORD LAYOUT (little endian)
+//  [0]     SNAPSHOT_MAGIC, 0xFF (erased) while the record is invalid
+//  [1]     SNAPSHOT_VERSION, bump it whenever the payload layout changes
+//  [2]     payload length n
+//  [3..]   payload
+//  [3+n..] CRC-16/CCITT over bytes 1 to 2+n
+//
+//writes run in the background off the EEPROM ready interrupt, one byte per interrupt, so the
+//3.3 ms a byte costs never stalls the scheduler
+//bytes that already hold the right value are skipped, a pause that only moved the bird rewrites
+//a handful of bytes. the magic is cleared first and set last, a write cut short by a power loss
+//leaves an invalid record rather than a mixed one
+
+#define SNAPSHOT_MAGIC 0x5A
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_HEADER 3
+#define SNAPSHOT_OVERHEAD (SNAPSHOT_HEADER + 2)
+#define SNAPSHOT_PAYLOAD_MAX 48
+#define SNAPSHOT_EEPROM_ADDR 0x100 //after the replay trace, well clear of the high score at 0x3FF
+
+GAME_LOCAL uint8_t snapshot_image[SNAPSHOT_OVERHEAD + SNAPSHOT_PAYLOAD_MAX];
+GAME_LOCAL uint8_t snapshot_len = 0;             //bytes in snapshot_image
+GAME_LOCAL volatile int snapshot_pos = -1;       //next byte to write, SNAPSHOT_CLEAR first, -1 when idle
+GAME_LOCAL volatile uint8_t snapshot_written = 0; //bytes that actually changed in the last write
+GAME_LOCAL volatile bool snapshot_done = false;  //a write finished, snapshot_poll reports it
+GAME_LOCAL uint16_t snapshot_started;            //CLOCK_NOW when the write began
+GAME_LOCAL volatile uint16_t snapshot_elapsed;   //clock counts the last write took
+
+#define SNAPSHOT_CLEAR (SNAPSHOT_OVERHEAD + SNAPSHOT_PAYLOAD_MAX) //pseudo position, erase the magic
+
+
+uint16_t snapshot_crc(const uint8_t *data, uint8_t len){
+    uint16_t crc = 0xFFFF;
+    for (uint8_t i = 0; i < len; i++){
+        crc ^= (uint16_t)data[i] << 8;
+        for (uint8_t b = 0; b < 8; b++){
+            crc = (crc & 0x8000) ? (crc << 1) ^ 0x1021 : crc << 1;
+        }
+    }
+    return crc;
+}
+
+//starts one EEPROM byte write if it differs, returns whether it did
+bool snapshot_put(unsigned int addr, uint8_t data){
+    if (EEPROM_read(addr) == data){
+        return false;
+    }
+    EEPROM_write_score(addr, data);
+    return true;
+}
+
+//walks the record until one byte needed writing, the next ready interrupt picks up after it
+//order is magic cleared, header and payload, magic last
+void snapshot_step(){
+    while (snapshot_pos >= 0){
+        int pos = snapshot_pos;
+        bool wrote;
+        if (pos == SNAPSHOT_CLEAR){
+            wrote = snapshot_put(SNAPSHOT_EEPROM_ADDR, 0xFF);
+            snapshot_pos = 1;
+        }
+        else if (pos > 0){
+            wrote = snapshot_put(SNAPSHOT_EEPROM_ADDR + pos, snapshot_image[pos]);
+            snapshot_pos = (pos + 1 < snapshot_len) ? pos + 1 : 0;
+        }
+        else {
+            wrote = snapshot_put(SNAPSHOT_EEPROM_ADDR, SNAPSHOT_MAGIC);
+            snapshot_pos = -1;
+        }
+        if (wrote){
+            snapshot_written++;
+            return;
+        }
+    }
+    EECR &= ~(1 << EERIE);
+    snapshot_elapsed = CLOCK_NOW() - snapshot_started;
+    snapshot_done = true;
+}
+
+ISR(EE_READY_vect){
+    TRACE_MARK(TRACE_EEPROM);
+    snapshot_step();
+}
+
+bool snapshot_busy(){
+    return snapshot_pos >= 0;
+}
+
+//stops a write in progress, the record stays invalid until the next snapshot_write
+void snapshot_cancel(){
+    EECR &= ~(1 << EERIE);
+    snapshot_pos = -1;
+    snapshot_done = false;
+}
+
+//queues a new record, replacing one still being written
+void snapshot_write(const uint8_t *payload, uint8_t len){
+    if (len > SNAPSHOT_PAYLOAD_MAX){
+        return;
+    }
+    snapshot_cancel();
+    snapshot_image[0] = SNAPSHOT_MAGIC;
+    snapshot_image[1] = SNAPSHOT_VERSION;
+    snapshot_image[2] = len;
+    for (uint8_t i = 0; i < len; i++){
+        snapshot_image[SNAPSHOT_HEADER + i] = payload[i];
+    }
+    uint16_t crc = snapshot_crc(&snapshot_image[1], SNAPSHOT_HEADER - 1 + len);
+    snapshot_image[SNAPSHOT_HEADER + len] = crc & 0xFF;
+    snapshot_image[SNAPSHOT_HEADER + len + 1] = crc >> 8;
+    snapshot_len = SNAPSHOT_OVERHEAD + len;
+
+    //a whole record is about 180 ms of writes, inside the clock's 262 ms wrap
+    snapshot_started = CLOCK_NOW();
+    snapshot_written = 0;
+    snapshot_pos = SNAPSHOT_CLEAR;
+    EECR |= (1 << EERIE); //fires straight away if no write is pending
+}
+
+//marks the stored record invalid, one byte write if it was valid
+void snapshot_erase(){
+    snapshot_cancel();
+    snapshot_put(SNAPSHOT_EEPROM_ADDR, 0xFF);
+}
+
+//copies a valid record's payload out, returns its length, -1 if there is none or it fails a check
+int snapshot_read(uint8_t *payload, uint8_t max){
+    uint8_t record[SNAPSHOT_OVERHEAD + SNAPSHOT_PAYLOAD_MAX];
+    EEPROM_read_block(SNAPSHOT_EEPROM_ADDR, record, SNAPSHOT_HEADER);
+    uint8_t len = record[2];
+    if (record[0] != SNAPSHOT_MAGIC || record[1] != SNAPSHOT_VERSION || len > max || len > SNAPSHOT_PAYLOAD_MAX){
+        return -1;
+    }
+    EEPROM_read_block(SNAPSHOT_EEPROM_ADDR + SNAPSHOT_HEADER, &record[SNAPSHOT_HEADER], len + 2);
+    uint16_t crc = snapshot_crc(&record[1], SNAPSHOT_HEADER - 1 + len);
+    if (crc != (record[SNAPSHOT_HEADER + len] | ((uint16_t)record[SNAPSHOT_HEADER + len + 1] << 8))){
+        return -1;
+    }
+    for (uint8_t i = 0; i < len; i++){
+        payload[i] = record[SNAPSHOT_HEADER + i];
+    }
+    return len;
+}
+
+//called every scheduler cycle, reports a finished write: "S saved", bytes written, ms taken
+void snapshot_poll(){
+    if (!snapshot_done){
+        return;
+    }
+    snapshot_done = false;
+    serial_println_P(PSTR("S saved"));
+    serial_println((long)snapshot_written);
+    serial_println((long)((unsigned long)snapshot_elapsed * CLOCK_US_PER_COUNT / 1000));
+}
+
+#endif /* SNAPSHOT_H */
@@ -0,0 +1,144 @@
+#ifndef SOUND_H
+#define SOUND_H
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "helper.h"
+#include "eventTrace.h"
+
+//SOUND EFFECTS
+//one buzzer voice, driven by Timer0 in CTC mode. every compare match is one edge of the tone:
+//TIMER0_COMPA_vect toggles the pin and counts the edges left in the step, and at zero it loads the
+//next step from flash. nothing waits, the tick functions only call sound_play()
+//
+//the ISR is a toggle and a countdown, a step change adds four flash reads and the Timer0
+//registers, the same work whatever is playing. the timer is stopped while nothing plays
+//
+//STEP LAYOUT (PROGMEM, 4 bytes a step, an effect ends with a 0 count)
+//  [0] OCR0A   [1] prescaler bits, SOUND_SILENT for a rest   [2..3] edges, little endian
+//
+//effects preempt by priority, their order in SOUND_ID: a playing effect ignores anything lower
+//and restarts on itself. TimerISR runs its tasks with only this ISR unmasked (task_window_open in
+//game.h), so it nests inside a long tick and the tone keeps its pitch
+//
+//the buzzer is on PC2 (SOUND_BIT), toggled in the ISR. every output compare pin of the Uno is
+//wired to the LCD or the SPI bus, so hardware toggling is the fallback: -DSOUND_OC0A moves the
+//buzzer to PD6, where Timer0 toggles it itself, PD6 is the LCD's D6 so that needs NO_LCD.
+//periph.h's TIMER0_init/yip/derp are the old Timer0 setup this replaces
+
+#ifndef F_CPU
+#define F_CPU 16000000UL
+#endif
+
+#ifdef SOUND_OC0A
+  #ifndef NO_LCD
+    #error "SOUND_OC0A drives PD6, the LCD's D6, build it with NO_LCD"
+  #endif
+  #define SOUND_PORT PORTD
+  #define SOUND_DDR DDRD
+  #define SOUND_BIT (1 << PORTD6)
+#else
+  #define SOUND_PORT PORTC
+  #define SOUND_DDR DDRC
+  #define SOUND_BIT (1 << 2) //PC2, free next to the buttons
+#endif
+
+#define SOUND_STEP 4
+#define SOUND_SILENT 0x80
+#define SOUND_CS64 ((1 << CS01) | (1 << CS00))
+#define SOUND_CS256 (1 << CS02)
+
+//prescaler /64 down to 489 Hz and /256 below it, the top has to fit in 8 bits
+#define SOUND_DIV(hz) ((hz) >= 489 ? 64UL : 256UL)
+#define SOUND_TOP(hz) (F_CPU / (2 * SOUND_DIV(hz) * (hz)) - 1)
+#define SOUND_EDGES(hz, ms) (2 * ((ms) * F_CPU / (2 * SOUND_DIV(hz) * (SOUND_TOP(hz) + 1) * 1000UL))) //whole periods
+#define SOUND_TONE(hz, ms) SOUND_TOP(hz), ((hz) >= 489 ? SOUND_CS64 : SOUND_CS256), \
+    SOUND_EDGES(hz, ms) & 0xFF, SOUND_EDGES(hz, ms) >> 8
+#define SOUND_REST(ms) 249, SOUND_CS64 | SOUND_SILENT, (ms) & 0xFF, (ms) >> 8 //one compare a ms
+#define SOUND_END 0, 0, 0, 0
+
+const uint8_t sound_jump[] PROGMEM = {SOUND_TONE(1319, 20), SOUND_TONE(1760, 30), SOUND_END};
+const uint8_t sound_score[] PROGMEM = {SOUND_TONE(1568, 40), SOUND_REST(10), SOUND_TONE(2093, 60), SOUND_END};
+const uint8_t sound_pause[] PROGMEM = {SOUND_TONE(880, 50), SOUND_TONE(659, 80), SOUND_END};
+const uint8_t sound_death[] PROGMEM = {SOUND_TONE(523, 80), SOUND_TONE(392, 80), SOUND_TONE(262, 120),
+    SOUND_REST(40), SOUND_TONE(131, 250), SOUND_END};
+
+enum SOUND_ID {SOUND_NONE, SOUND_JUMP, SOUND_SCORE, SOUND_PAUSE, SOUND_DEATH};
+const uint8_t *const sound_effects[] PROGMEM = {NULL, sound_jump, sound_score, sound_pause, sound_death};
+
+GAME_LOCAL volatile uint8_t sound_playing = SOUND_NONE;
+GAME_LOCAL const uint8_t *volatile sound_step;  //step being played
+GAME_LOCAL volatile uint16_t sound_left = 0;    //edges left in it
+GAME_LOCAL volatile bool sound_silent = false;
+
+void sound_init(){
+    SOUND_DDR |= SOUND_BIT;
+    SOUND_PORT &= ~SOUND_BIT;
+    TCCR0A = (1 << WGM01); //CTC, TOP is OCR0A
+    TCCR0B = 0;
+    TIMSK0 = 0;
+}
+
+void sound_stop(){
+    TCCR0B = 0;
+    TIMSK0 &= ~(1 << OCIE0A);
+    TCCR0A = (1 << WGM01);
+    SOUND_PORT &= ~SOUND_BIT;
+    sound_playing = SOUND_NONE;
+}
+
+//starts the step at sound_step, or stops after the last one
+void sound_load(){
+    TRACE_MARK(TRACE_SOUND);
+    const uint8_t *s = sound_step;
+    uint16_t edges = pgm_read_byte(s + 2) | (pgm_read_byte(s + 3) << 8);
+    if (edges == 0){
+        sound_stop();
+        return;
+    }
+    uint8_t cs = pgm_read_byte(s + 1);
+    sound_silent = cs & SOUND_SILENT;
+    sound_left = edges;
+#ifdef SOUND_OC0A
+    TCCR0A = sound_silent ? (1 << WGM01) : (1 << WGM01) | (1 << COM0A0); //the pin toggles itself
+#endif
+    OCR0A = pgm_read_byte(s);
+    TCNT0 = 0;
+    TCCR0B = cs & ~SOUND_SILENT;
+}
+
+//one compare match, the whole ISR
+inline void sound_edge(){
+#ifndef SOUND_OC0A
+    if (!sound_silent){
+        SOUND_PORT ^= SOUND_BIT;
+    }
+#endif
+    if (--sound_left == 0){
+        sound_step += SOUND_STEP;
+        sound_load();
+    }
+}
+
+ISR(TIMER0_COMPA_vect){
+    sound_edge();
+}
+
+//one call from a tick function, returns whether the effect started
+bool sound_play(uint8_t id){
+    if (id == SOUND_NONE || id < sound_playing){
+        return false;
+    }
+    uint8_t sreg = SREG;
+    cli();
+    sound_playing = id;
+    sound_step = (const uint8_t *)pgm_read_ptr(&sound_effects[id]);
+    sound_load();
+    TIFR0 = (1 << OCF0A);
+    TIMSK0 |= (1 << OCIE0A);
+    SREG = sreg;
+    return true;
+}
+
+#endif /* SOUND_H */
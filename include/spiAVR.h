@@ -3,6 +3,8 @@
 #include <avr/io.h>
 #include <avr/interrupt.h>
 #include <util/delay.h>
+#include "displayBus.h"
+#include "eventTrace.h"
 
 //B5 should always be SCK(spi clock) and B3 should always be MOSI. If you are using an
 //SPI peripheral that sends data back to the arduino, you will need to use B4 as the MISO pin.
@@ -10,23 +12,27 @@
 //the SPI_SEND() funtion, you will need to set your SS pin to low. If you have multiple SPI
 //devices, they will share the SCK, MOSI and MISO pins but should have different SS pins.
 //To send a value to a specific device, set it's SS pin to low and all other SS pins to high.
+//The bytes go out through displayBus.h, hardware SPI unless the build picks DISPLAY_BUS_MSPIM.
 
-// Outputs, pin definitions BIT MASKS (FIXED!)
-#define PIN_SCK      (1 << PORTB5)  // Pin 13 - SCK
-#define PIN_MOSI     (1 << PORTB3)  // Pin 11 - MOSI
+// Outputs, pin definitions BIT MASKS (FIXED!), SCK and MOSI come from displayBus.h
 #define PIN_SS       (1 << PORTB2)  // Pin 10 - CS
 #define A0           (1 << PORTB1)  // Pin 9 - DC
 #define RESET_PIN    (1 << PORTB0)  // Pin 8  - RESET
 
 void SPI_INIT(){
-    DDRB |= PIN_SCK | PIN_MOSI | PIN_SS | A0 | RESET_PIN;  // Set as outputs
+    DDRB |= PIN_SS | A0 | RESET_PIN;  // Set as outputs
     PORTB|= PIN_SS;  // CS starts HIGH (deselected)
-    SPCR |= (1 << SPE) | (1 << MSTR);  // Enable SPI, Master mode
+    BUS_INIT();
 }
 
 void SPI_SEND(char data){
-    SPDR = data;  // Set data to transmit
-    while (!(SPSR & (1 << SPIF)));  // Wait until done transmitting
+    BUS_SEND(data);
+}
+
+//CS HIGH once the last byte is out, a buffered bus may still be shifting when SPI_SEND returns
+void SPI_DESELECT(){
+    BUS_FLUSH();
+    PORTB |= PIN_SS;
 }
 
 //PIN BASED RESET
@@ -43,7 +49,7 @@ void SendCommand(uint8_t command){
     PORTB &= ~PIN_SS;  // CS LOW - select display
     PORTB &= ~A0;      // DC LOW - command mode
     SPI_SEND(command);
-    PORTB |= PIN_SS;   // CS HIGH - deselect display
+    SPI_DESELECT();    // CS HIGH - deselect display
 }
 
 // Command hex codes
@@ -55,6 +61,41 @@ void SendCommand(uint8_t command){
 #define INVERT  0x21
 #define REVERT  0x20
 
+//COLOR MODE
+//RGB565 (COLMOD 0x05) by default, two bytes a pixel
+//TFT_COLOR_444 runs the panel in RGB444 (COLMOD 0x03), two pixels in three bytes: R1G1 B1R2 G2B2
+//an odd count sends its last pixel as two bytes, the panel drops the spare nibble at the next
+//command. colors stay RGB565 in the code, the top four bits of each channel go to the panel
+#ifdef TFT_COLOR_444
+  #define TFT_COLMOD 0x03
+#else
+  #define TFT_COLMOD 0x05
+#endif
+
+//RGB565 to RGB444
+#define TFT_444(c) ((((c) >> 4) & 0xF00) | (((c) >> 3) & 0x0F0) | (((c) >> 1) & 0x00F))
+
+//bus bytes for n pixels in one stream
+#ifdef TFT_COLOR_444
+  #define TFT_PIXEL_BYTES(n) ((3UL * (n) + 1) / 2)
+#else
+  #define TFT_PIXEL_BYTES(n) (2UL * (n))
+#endif
+
+//color mode and orientation, what the panel needs before the first RAMWR
+void ST7735_config(){
+    SendCommand(COLMOD);
+    PORTB &= ~PIN_SS;  // CS LOW - select display
+    PORTB |= A0;       // DC HIGH - data mode
+    SPI_SEND(TFT_COLMOD);  // RGB565, or RGB444 with TFT_COLOR_444
+    SPI_DESELECT();    // CS HIGH - deselect display
+    SendCommand(MADCTL);
+    PORTB &= ~PIN_SS;  // CS LOW - select display
+    PORTB |= A0;       // DC HIGH - data mode
+    SPI_SEND(0x80);  //1000 0000
+    SPI_DESELECT();    // CS HIGH - deselect display
+}
+
 void ST7735_init(){
     HardwareReset();
     SendCommand(SWRESET);
@@ -64,8 +105,8 @@ void ST7735_init(){
     SendCommand(COLMOD);
     PORTB &= ~PIN_SS;  // CS LOW - select display
     PORTB |= A0;       // DC HIGH - data mode
-    SPI_SEND(0x05);  // 16-bit color mode (RGB565)
-    PORTB |= PIN_SS;   // CS HIGH - deselect display
+    SPI_SEND(TFT_COLMOD);  // RGB565, or RGB444 with TFT_COLOR_444
+    SPI_DESELECT();    // CS HIGH - deselect display
     _delay_ms(500);
     SendCommand(DISPON);
     _delay_ms(500);
@@ -73,7 +114,7 @@ void ST7735_init(){
     PORTB &= ~PIN_SS;  // CS LOW - select display
     PORTB |= A0;       // DC HIGH - data mode
     SPI_SEND(0x80);  //1000 0000
-    PORTB |= PIN_SS;   // CS HIGH - deselect display
+    SPI_DESELECT();    // CS HIGH - deselect display
 }
 
 
@@ -91,35 +132,163 @@ void SetWriteWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1){
         PORTB |= A0;       // DC HIGH - data mode
         SPI_SEND(0x00);SPI_SEND(x0);           
         SPI_SEND(0x00);SPI_SEND(x1);           
-        PORTB |= PIN_SS;   // CS HIGH - deselect display
+        SPI_DESELECT();    // CS HIGH - deselect display
     
     SendCommand(RASET);
         PORTB &= ~PIN_SS;  // CS LOW - select display
         PORTB |= A0;       // DC HIGH - data mode
         SPI_SEND(0x00);SPI_SEND(y0);           
         SPI_SEND(0x00);SPI_SEND(y1);           
-        PORTB |= PIN_SS;   // CS HIGH - deselect display
+        SPI_DESELECT();    // CS HIGH - deselect display
     
     SendCommand(RAMWR);
 }
 
-void FillWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint16_t color){
+//count pixels of one color into an open data transfer
+void SendColor(uint32_t count, uint16_t color){
+#ifdef TFT_COLOR_444
+    uint16_t c = TFT_444(color);
+    uint8_t rg = c >> 4;
+    uint8_t br = ((c & 0x0F) << 4) | (c >> 8);
+    uint8_t gb = c & 0xFF;
 
-    uint32_t total = (x1 - x0 + 1) * (y1 - y0 + 1);  // total pixels
+    for(uint32_t i = count / 2; i > 0; i--){
+        SPI_SEND(rg);
+        SPI_SEND(br);
+        SPI_SEND(gb);
+    }
+    if (count & 1){
+        SPI_SEND(rg);
+        SPI_SEND(br & 0xF0);
+    }
+#else
     uint8_t hi = color >> 8;
     uint8_t lo = color & 0xFF;
 
-    PORTB &= ~PIN_SS;   // CS LOW (start pixel stream)
-    PORTB |= A0;        // DC HIGH (data mode)
-
-    for(uint32_t i = 0; i < total; i++){
+    for(uint32_t i = 0; i < count; i++){
         SPI_SEND(hi);
         SPI_SEND(lo);
     }
+#endif
+}
 
-    PORTB |= PIN_SS;    // CS HIGH (end pixel stream)
+//count RGB565 pixels from memory into an open data transfer
+void SendPixelArray(const uint16_t *pixels, uint16_t count){
+#ifdef TFT_COLOR_444
+    uint16_t i = 0;
+    for(; i + 1 < count; i += 2){
+        uint16_t a = TFT_444(pixels[i]);
+        uint16_t b = TFT_444(pixels[i + 1]);
+        SPI_SEND(a >> 4);
+        SPI_SEND(((a & 0x0F) << 4) | (b >> 8));
+        SPI_SEND(b & 0xFF);
+    }
+    if (i < count){
+        uint16_t a = TFT_444(pixels[i]);
+        SPI_SEND(a >> 4);
+        SPI_SEND((a & 0x0F) << 4);
+    }
+#else
+    for(uint16_t i = 0; i < count; i++){
+        SPI_SEND(pixels[i] >> 8);
+        SPI_SEND(pixels[i] & 0xFF);
+    }
+#endif
 }
 
+//a pixel stream fed in pieces that may end on an odd pixel, RGB444 holds that one back for its pair
+struct pixel_stream {
+    uint16_t held;
+    bool half;
+};
+
+//one pixel already in the panel's format, TFT_444() it first in RGB444 builds
+inline void StreamPut(struct pixel_stream *s, uint16_t c){
+#ifdef TFT_COLOR_444
+    if (!s->half){
+        s->held = c;
+        s->half = true;
+    }
+    else {
+        SPI_SEND(s->held >> 4);
+        SPI_SEND(((s->held & 0x0F) << 4) | (c >> 8));
+        SPI_SEND(c & 0xFF);
+        s->half = false;
+    }
+#else
+    SPI_SEND(c >> 8);
+    SPI_SEND(c & 0xFF);
+#endif
+}
 
+//count pixels of one RGB565 color, SendColor with the pairing carried across calls
+void StreamRun(struct pixel_stream *s, uint32_t count, uint16_t color){
+#ifdef TFT_COLOR_444
+    uint16_t c = TFT_444(color);
+    if (s->half && count > 0){
+        StreamPut(s, c);
+        count--;
+    }
+    SendColor(count & ~1UL, color);
+    if (count & 1){
+        s->held = c;
+        s->half = true;
+    }
+#else
+    SendColor(count, color);
+#endif
+}
+
+//sends a held RGB444 pixel, padded, at the end of the stream
+inline void StreamEnd(struct pixel_stream *s){
+#ifdef TFT_COLOR_444
+    if (s->half){
+        SPI_SEND(s->held >> 4);
+        SPI_SEND((s->held & 0x0F) << 4);
+        s->half = false;
+    }
+#endif
+}
+
+void FillWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, uint16_t color){
+
+    uint32_t total = (x1 - x0 + 1) * (y1 - y0 + 1);  // total pixels
+
+    TRACE_BEGIN(TRACE_SPI);
+    PORTB &= ~PIN_SS;   // CS LOW (start pixel stream)
+    PORTB |= A0;        // DC HIGH (data mode)
+
+    SendColor(total, color);
+
+    SPI_DESELECT();     // CS HIGH (end pixel stream)
+    TRACE_END(TRACE_SPI);
+}
+
+//sets the window and writes (x1-x0+1)*(y1-y0+1) RGB565 pixels into it, row by row
+void BlitWindow(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1, const uint16_t *pixels){
+    SetWriteWindow(x0, y0, x1, y1);
+
+    TRACE_BEGIN(TRACE_SPI);
+    PORTB &= ~PIN_SS;   // CS LOW (start pixel stream)
+    PORTB |= A0;        // DC HIGH (data mode)
+
+    SendPixelArray(pixels, (x1 - x0 + 1) * (y1 - y0 + 1));
+
+    SPI_DESELECT();     // CS HIGH (end pixel stream)
+    TRACE_END(TRACE_SPI);
+}
+
+
+//continues a RAMWR stream with count more pixels, the panel keeps its write position
+//across CS going high so a big fill can be split up between other work
+//in RGB444 a pixel pair shares a byte, only the last piece of a stream may have an odd count
+void StreamPixels(uint16_t count, uint16_t color){
+    TRACE_BEGIN(TRACE_SPI);
+    PORTB &= ~PIN_SS;   // CS LOW
+    PORTB |= A0;        // DC HIGH (data mode)
+    SendColor(count, color);
+    SPI_DESELECT();     // CS HIGH
+    TRACE_END(TRACE_SPI);
+}
 
 #endif /* SPIAVR_H */
\ No newline at end of file
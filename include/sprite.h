@@ -0,0 +1,130 @@
+#ifndef SPRITE_H
+#define SPRITE_H
+
+#include <avr/io.h>
+#include <avr/pgmspace.h>
+#include "spiAVR.h"
+
+//SPRITE BLITTER
+//sprites and their palettes live in flash, pixels are expanded through the palette straight
+//into the RAMWR stream, nothing is buffered in SRAM
+//
+//SPRITE LAYOUT (PROGMEM bytes)
+//  [0] width   [1] height   [2] bits per pixel, 1 or 2
+//  [3..] rows, lowest y first like the panel's rows, each row starts on a new byte,
+//        pixels packed from the most significant bit
+//
+//a palette is 2 or 4 RGB565 words in flash, one per pixel value. value 0 is the transparent one:
+//  default        it is drawn in palette[0], set that to the background and the sprite's box
+//                 erases whatever was under it, one window for the whole sprite
+//  SPRITE_KEYED   it is skipped, every row is split into runs of visible pixels with a window
+//                 each, so the sprite sits on top of pipes at the cost of 11 bytes per run
+//
+//(x, y) is the sprite's lowest left pixel, anything off the panel is clipped
+
+#define SPRITE_HEADER 3
+#define SPRITE_KEYED 0x01
+
+//palette for this build's color mode and the stream it feeds
+struct sprite_out {
+    uint16_t lut[4];
+    struct pixel_stream px;
+};
+
+inline void sprite_put(struct sprite_out *out, uint8_t value){
+    StreamPut(&out->px, out->lut[value]);
+}
+
+//pixel value of column c in a row
+inline uint8_t sprite_value(const uint8_t *row, uint8_t c, uint8_t bpp){
+    uint8_t bit = c * bpp;
+    return (pgm_read_byte(row + (bit >> 3)) >> (8 - bpp - (bit & 7))) & ((1 << bpp) - 1);
+}
+
+//streams columns c0..c1 of a row, one flash read per byte of pixels
+void sprite_row(struct sprite_out *out, const uint8_t *row, uint8_t c0, uint8_t c1, uint8_t bpp){
+    uint8_t bit = c0 * bpp;
+    const uint8_t *p = row + (bit >> 3);
+    uint8_t bits = pgm_read_byte(p++) << (bit & 7);
+    uint8_t left = (8 - (bit & 7)) / bpp; //pixels still in bits
+
+    for (uint8_t c = c0; c <= c1; c++){
+        if (left == 0){
+            bits = pgm_read_byte(p++);
+            left = 8 / bpp;
+        }
+        sprite_put(out, bits >> (8 - bpp));
+        bits <<= bpp;
+        left--;
+    }
+}
+
+void BlitSprite(const uint8_t *sprite, int16_t x, int16_t y, const uint16_t *palette, uint8_t flags = 0){
+    uint8_t w = pgm_read_byte(sprite);
+    uint8_t h = pgm_read_byte(sprite + 1);
+    uint8_t bpp = pgm_read_byte(sprite + 2);
+    uint8_t stride = (w * bpp + 7) / 8;
+    const uint8_t *bits = sprite + SPRITE_HEADER;
+
+    //visible part, in sprite columns and rows
+    int16_t c0 = (x < XS) ? XS - x : 0;
+    int16_t c1 = (x + w - 1 > XE) ? XE - x : w - 1;
+    int16_t r0 = (y < YS) ? YS - y : 0;
+    int16_t r1 = (y + h - 1 > YE) ? YE - y : h - 1;
+    if (c0 > c1 || r0 > r1){
+        return;
+    }
+
+    struct sprite_out out;
+    out.px.half = false;
+    for (uint8_t v = 0; v < (1 << bpp); v++){
+        uint16_t c = pgm_read_word(&palette[v]);
+#ifdef TFT_COLOR_444
+        out.lut[v] = TFT_444(c);
+#else
+        out.lut[v] = c;
+#endif
+    }
+
+    if (!(flags & SPRITE_KEYED)){
+        SetWriteWindow(x + c0, y + r0, x + c1, y + r1);
+        TRACE_BEGIN(TRACE_SPI);
+        PORTB &= ~PIN_SS;   // CS LOW (start pixel stream)
+        PORTB |= A0;        // DC HIGH (data mode)
+        for (int16_t r = r0; r <= r1; r++){
+            sprite_row(&out, bits + r * stride, c0, c1, bpp);
+        }
+        StreamEnd(&out.px);
+        SPI_DESELECT();     // CS HIGH (end pixel stream)
+        TRACE_END(TRACE_SPI);
+        return;
+    }
+
+    //one span for all the runs, each has its own window inside it
+    TRACE_BEGIN(TRACE_SPI);
+    for (int16_t r = r0; r <= r1; r++){
+        const uint8_t *row = bits + r * stride;
+        int16_t c = c0;
+        while (c <= c1){
+            //skip the transparent run, then find the end of the visible one
+            while (c <= c1 && sprite_value(row, c, bpp) == 0){
+                c++;
+            }
+            int16_t start = c;
+            while (c <= c1 && sprite_value(row, c, bpp) != 0){
+                c++;
+            }
+            if (start < c){
+                SetWriteWindow(x + start, y + r, x + c - 1, y + r);
+                PORTB &= ~PIN_SS;
+                PORTB |= A0;
+                sprite_row(&out, row, start, c - 1, bpp);
+                StreamEnd(&out.px);
+                SPI_DESELECT();
+            }
+        }
+    }
+    TRACE_END(TRACE_SPI);
+}
+
+#endif /* SPRITE_H */
@@ -0,0 +1,167 @@
+#ifndef STACKPAINT_H
+#define STACKPAINT_H
+
+#include <avr/io.h>
+#include "helper.h"
+#include "serialATmega.h"
+
+//STACK AND SRAM HIGH-WATER
+//free SRAM is painted with STACK_CANARY before main runs. whatever the stack has touched since
+//is no longer canary, so the lowest written byte is how far it ever grew towards .bss
+//
+//  stack_unused()   bytes between the end of .bss and the deepest write since boot, the headroom
+//  stack_free()     bytes between the end of .bss and the stack pointer right now
+//  stack_task_max   deepest each task went below the scheduler's frame in any of its ticks
+//
+//TimerISR brackets every tick function with stack_task_begin/stack_task_end. the end scans for
+//the task's deepest write and paints what it used back to canary, so the next task starts clean.
+//a tick costs a scan and a repaint of the bytes the task used, plus STACK_GAP reads below the mark
+//remote_poll and snapshot_check are measured together in the STACK_SCHED slot
+//
+//nothing mallocs, so the end of .bss (_end) is the floor. the remote 'm' command prints it all,
+//the same code reports on the uno and the 1284, RAMEND and the linker symbols follow the part
+//the host build has no stack to paint, the calls compile to nothing there
+
+#define STACK_CANARY 0xC5
+#define STACK_TASKS 8                    //slots, NUM_TASKS tasks then STACK_SCHED
+#define STACK_SCHED (STACK_TASKS - 1)
+#define STACK_GAP 64                     //canary bytes in a row that end the scan below the mark
+#define STACK_SRAM (RAMEND - RAMSTART + 1)
+
+GAME_LOCAL uint16_t stack_task_max[STACK_TASKS];
+GAME_LOCAL uint8_t stack_tasks = 0; //task slots seen, for the report
+
+#ifndef HOST_BUILD
+
+extern uint8_t _end;     //first byte after .bss
+extern uint8_t __stack;  //RAMEND, the stack grows down from here
+
+GAME_LOCAL uint8_t *stack_low = &__stack; //deepest write found so far
+
+//runs from .init1, before the stack pointer is set, so no frame, no C. fills _end up to __stack
+void stack_paint() __attribute__((naked, used, section(".init1")));
+void stack_paint(){
+    __asm volatile (
+        "    ldi r30, lo8(_end)\n"
+        "    ldi r31, hi8(_end)\n"
+        "    ldi r24, %0\n"
+        "    ldi r25, hi8(__stack)\n"
+        "    rjmp 2f\n"
+        "1:\n"
+        "    st Z+, r24\n"
+        "2:\n"
+        "    cpi r30, lo8(__stack)\n"
+        "    cpc r31, r25\n"
+        "    brlo 1b\n"
+        "    breq 1b\n"
+        :
+        : "i" (STACK_CANARY)
+    );
+}
+
+inline uint8_t *stack_pointer(){
+    return (uint8_t *)(uintptr_t)SP;
+}
+
+inline uint16_t stack_static(){
+    return &_end - (uint8_t *)RAMSTART; //.data and .bss
+}
+
+inline uint16_t stack_free(){
+    return stack_pointer() - &_end;
+}
+
+//walks up from the floor to the first written byte, the whole free region in the worst case
+uint16_t stack_unused(){
+    uint8_t *p = &_end;
+    while (p < stack_low && *p == STACK_CANARY){
+        p++;
+    }
+    stack_low = p;
+    return p - &_end;
+}
+
+//paints from p up to the stack pointer, everything below the caller's frame
+inline void stack_repaint(uint8_t *p){
+    uint8_t *sp = stack_pointer();
+    while (p < sp){
+        *p++ = STACK_CANARY;
+    }
+}
+
+//after boot_run, boot's own use stays in stack_low and the rest is painted again for the tasks
+void stack_init(){
+    stack_unused();
+    stack_repaint(stack_low);
+}
+
+inline uint8_t *stack_task_begin(){
+    return stack_pointer();
+}
+
+//slot's deepest write this tick, measured from top, the stack pointer stack_task_begin returned
+void stack_task_end(uint8_t slot, uint8_t *top){
+    uint8_t *deepest = NULL;
+    uint8_t *p = stack_low;
+    uint8_t run = 0;
+    //below the mark is canary unless this tick went deeper, a frame can leave gaps in what it writes
+    while (p > &_end && run < STACK_GAP){
+        p--;
+        if (*p != STACK_CANARY){
+            deepest = p;
+            run = 0;
+        }
+        else {
+            run++;
+        }
+    }
+    if (deepest != NULL){
+        stack_low = deepest;
+    }
+    else {
+        //stayed above the mark, the area between was painted after the last tick
+        uint8_t *sp = stack_pointer();
+        deepest = stack_low;
+        while (deepest < sp && *deepest == STACK_CANARY){
+            deepest++;
+        }
+    }
+    if (slot < STACK_SCHED && slot >= stack_tasks){
+        stack_tasks = slot + 1;
+    }
+    if (deepest < top && (uint16_t)(top - deepest) > stack_task_max[slot]){
+        stack_task_max[slot] = top - deepest;
+    }
+    stack_repaint(deepest);
+}
+
+#else
+
+inline uint16_t stack_static(){ return 0; }
+inline uint16_t stack_free(){ return 0; }
+inline uint16_t stack_unused(){ return 0; }
+inline void stack_init(){}
+inline uint8_t *stack_task_begin(){ return NULL; }
+inline void stack_task_end(uint8_t slot, uint8_t *top){}
+
+#endif
+
+//name is in flash, index a digit after it or 0
+void stack_line(const char *name, long value, char index = 0){
+    serial_report_P('M', name, value, index);
+}
+
+//"M <name> <bytes>" lines for the remote 'm' command, tasks in task table order, then "M done"
+void stack_report(){
+    stack_line(PSTR("sram"), STACK_SRAM);
+    stack_line(PSTR("static"), stack_static());
+    stack_line(PSTR("unused"), stack_unused());
+    stack_line(PSTR("free"), stack_free());
+    for (uint8_t i = 0; i < stack_tasks; i++){
+        stack_line(PSTR("task"), stack_task_max[i], '0' + i);
+    }
+    stack_line(PSTR("sched"), stack_task_max[STACK_SCHED]);
+    serial_println_P(PSTR("M done"));
+}
+
+#endif /* STACKPAINT_H */
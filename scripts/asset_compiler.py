@@ -0,0 +1,211 @@
+#!/usr/bin/env python3
+"""Compiles assets/*.png into run length images for include/rleImage.h.
+
+Writes include/assets.h, one PROGMEM byte array per image plus its size and
+a digest the host check compares the decoder against, and prints the
+compression of each image. Runs as a PlatformIO pre: script before every
+build and only rewrites the header when an image changed.
+
+    python3 scripts/asset_compiler.py              # regenerate include/assets.h
+    python3 scripts/asset_compiler.py --budget 4096
+
+Only the standard library is used. PNGs must be 8-bit grayscale, RGB, RGBA
+or palette (1, 2, 4 or 8 bit), not interlaced, at most 255 pixels a side
+and 16 colors. Alpha is ignored.
+"""
+import argparse
+import glob
+import os
+import struct
+import sys
+import zlib
+
+RLE_HEADER = 3
+RLE_LONG = 0x0F
+RLE_LONG_MIN = 16
+RLE_LONG_MAX = RLE_LONG_MIN + 255
+MAX_COLORS = 16
+DEFAULT_BUDGET = 6144  # flash bytes all images may take together
+
+
+def read_png(path):
+    """Returns rows of (r, g, b), top row first."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:8] != b"\x89PNG\r\n\x1a\n":
+        raise ValueError("%s: not a PNG" % path)
+    pos, idat, plte = 8, b"", None
+    while pos < len(data):
+        length, kind = struct.unpack(">I4s", data[pos:pos + 8])
+        body = data[pos + 8:pos + 8 + length]
+        pos += 12 + length
+        if kind == b"IHDR":
+            w, h, depth, ctype, _, _, interlace = struct.unpack(">IIBBBBB", body)
+        elif kind == b"PLTE":
+            plte = [tuple(body[i:i + 3]) for i in range(0, len(body), 3)]
+        elif kind == b"IDAT":
+            idat += body
+        elif kind == b"IEND":
+            break
+    if interlace:
+        raise ValueError("%s: interlaced PNGs are not supported" % path)
+    channels = {0: 1, 2: 3, 3: 1, 6: 4}.get(ctype)
+    if channels is None or (ctype != 3 and depth != 8) or depth not in (1, 2, 4, 8):
+        raise ValueError("%s: color type %d at %d bits is not supported" % (path, ctype, depth))
+
+    raw = zlib.decompress(idat)
+    bpp = max(1, channels * depth // 8)  # filter unit in bytes
+    stride = (w * channels * depth + 7) // 8
+    rows, prev, pos = [], bytearray(stride), 0
+    for _ in range(h):
+        ftype, line = raw[pos], bytearray(raw[pos + 1:pos + 1 + stride])
+        pos += 1 + stride
+        for i in range(stride):
+            a = line[i - bpp] if i >= bpp else 0
+            b = prev[i]
+            c = prev[i - bpp] if i >= bpp else 0
+            if ftype == 1:
+                line[i] = (line[i] + a) & 0xFF
+            elif ftype == 2:
+                line[i] = (line[i] + b) & 0xFF
+            elif ftype == 3:
+                line[i] = (line[i] + (a + b) // 2) & 0xFF
+            elif ftype == 4:
+                p = a + b - c
+                pa, pb, pc = abs(p - a), abs(p - b), abs(p - c)
+                line[i] = (line[i] + (a if pa <= pb and pa <= pc else b if pb <= pc else c)) & 0xFF
+        prev = line
+
+        if ctype == 3:
+            per = 8 // depth
+            idx = [(line[x // per] >> (8 - depth * (x % per + 1))) & ((1 << depth) - 1) for x in range(w)]
+            rows.append([plte[i] for i in idx])
+        elif ctype == 0:
+            rows.append([(v, v, v) for v in line[:w]])
+        else:
+            rows.append([tuple(line[x * channels:x * channels + 3]) for x in range(w)])
+    return rows
+
+
+def panel_color(rgb):
+    """RGB888 to the panel's 16-bit order, red in the low bits like RED in game.h."""
+    r, g, b = rgb
+    return ((b >> 3) << 11) | ((g >> 2) << 5) | (r >> 3)
+
+
+def fnv1a64(words):
+    h = 0xCBF29CE484222325
+    for w in words:
+        h = ((h ^ w) * 0x100000001B3) & 0xFFFFFFFFFFFFFFFF
+    return h
+
+
+def compile_image(path):
+    """Returns (image bytes, stream pixels) for one PNG."""
+    rows = read_png(path)
+    h, w = len(rows), len(rows[0])
+    if w > 255 or h > 255:
+        raise ValueError("%s: %dx%d is larger than 255 a side" % (path, w, h))
+
+    # stream order is lowest y first, the PNG's bottom row
+    pixels = [panel_color(p) for row in reversed(rows) for p in row]
+    counts = {}
+    for c in pixels:
+        counts[c] = counts.get(c, 0) + 1
+    if len(counts) > MAX_COLORS:
+        raise ValueError("%s: %d colors, at most %d" % (path, len(counts), MAX_COLORS))
+    palette = sorted(counts, key=lambda c: -counts[c])
+    index = {c: i for i, c in enumerate(palette)}
+
+    out = bytearray([w, h, len(palette)])
+    for c in palette:
+        out += struct.pack("<H", c)
+    i = 0
+    while i < len(pixels):
+        j = i
+        while j < len(pixels) and pixels[j] == pixels[i] and j - i < RLE_LONG_MAX:
+            j += 1
+        n = j - i
+        if n < RLE_LONG_MIN:
+            out.append((index[pixels[i]] << 4) | (n - 1))
+        else:
+            out += bytes([(index[pixels[i]] << 4) | RLE_LONG, n - RLE_LONG_MIN])
+        i = j
+    return bytes(out), pixels
+
+
+def render_header(images):
+    lines = [
+        "//GENERATED by scripts/asset_compiler.py from assets/*.png, do not edit",
+        "//run length images for rleImage.h, DrawImage(asset_<name>, x, y)",
+        "//",
+        "//%-12s %8s %10s %10s %7s" % ("image", "pixels", "raw bytes", "rle bytes", "ratio"),
+    ]
+    for name, data, pixels in images:
+        lines.append("//%-12s %8d %10d %10d %6.1fx" % (name, len(pixels), 2 * len(pixels), len(data),
+                                                     2.0 * len(pixels) / len(data)))
+    lines += ["", "#ifndef ASSETS_H", "#define ASSETS_H", "", "#include <stdint.h>",
+              "#include <avr/pgmspace.h>", ""]
+    for name, data, pixels in images:
+        upper = name.upper()
+        lines.append("#define ASSET_%s_W %d" % (upper, data[0]))
+        lines.append("#define ASSET_%s_H %d" % (upper, data[1]))
+        lines.append("#define ASSET_%s_FNV 0x%016XULL //FNV-1a of the RGB565 pixels in stream order"
+                     % (upper, fnv1a64(pixels)))
+        lines.append("const uint8_t asset_%s[] PROGMEM = {" % name)
+        for i in range(0, len(data), 16):
+            lines.append("    " + ", ".join("0x%02X" % b for b in data[i:i + 16]) + ",")
+        lines += ["};", ""]
+    lines.append("#endif /* ASSETS_H */")
+    return "\n".join(lines) + "\n"
+
+
+def compile_assets(src, header, budget, quiet=False):
+    images = []
+    for path in sorted(glob.glob(os.path.join(src, "*.png"))):
+        name = os.path.splitext(os.path.basename(path))[0].lower()
+        data, pixels = compile_image(path)
+        images.append((name, data, pixels))
+
+    total = sum(len(data) for _, data, _ in images)
+    if not quiet:
+        for name, data, pixels in images:
+            print("asset %-12s %5d px %6d -> %5d bytes %6.1fx" % (name, len(pixels), 2 * len(pixels), len(data),
+                                                                2.0 * len(pixels) / len(data)))
+        print("assets %d bytes of flash, budget %d" % (total, budget))
+    if total > budget:
+        raise ValueError("assets take %d bytes of flash, over the %d byte budget" % (total, budget))
+
+    text = render_header(images)
+    old = open(header).read() if os.path.exists(header) else None
+    if text != old:
+        with open(header, "w") as f:
+            f.write(text)
+        if not quiet:
+            print("wrote %s" % header)
+
+
+def main():
+    root = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--src", default=os.path.join(root, "assets"))
+    ap.add_argument("--out", default=os.path.join(root, "include", "assets.h"))
+    ap.add_argument("--budget", type=int, default=DEFAULT_BUDGET, help="flash bytes the images may take")
+    args = ap.parse_args()
+    try:
+        compile_assets(args.src, args.out, args.budget)
+    except ValueError as e:
+        sys.exit(str(e))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+elif "Import" in globals():
+    # PlatformIO extra_scripts = pre:scripts/asset_compiler.py, __file__ is not set under SCons
+    Import("env")  # noqa: F821
+    _root = env["PROJECT_DIR"]  # noqa: F821
+    try:
+        compile_assets(os.path.join(_root, "assets"), os.path.join(_root, "include", "assets.h"), DEFAULT_BUDGET)
+    except ValueError as e:
+        sys.exit(str(e))
@@ -0,0 +1,175 @@
+#!/usr/bin/env python3
+"""Cycle benchmarks for the drivers and tick functions under simavr.
+
+Runs the env:avrbench firmware (src/avr_bench.cpp) in simavr, reads the
+"B <name> <cycles>" lines it prints over the UART and compares them with
+the baseline file. Any benchmark more than --threshold percent slower
+than its baseline fails the run. Without a baseline file the run prints
+the counts and "SKIP", and exits 0 without checking anything.
+
+    python3 scripts/avr_bench.py --build --update   # record a new baseline
+    python3 scripts/avr_bench.py --build            # check against it
+    python3 scripts/avr_bench.py --build --compare  # display bus bytes/s, SPI vs USART-MSPIM
+    python3 scripts/avr_bench.py --per-pixel        # cycles per pixel, sprite and image draws vs FillWindow
+"""
+import argparse
+import os
+import re
+import subprocess
+import sys
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+LINE = re.compile(r"(?:^|\W)([BNP]) (\S+) (\d+)")
+ANSI = re.compile(r"\x1b\[[0-9;]*m")
+
+
+def build(env="avrbench"):
+    try:
+        subprocess.run(["pio", "run", "-e", env], cwd=ROOT, check=True)
+    except FileNotFoundError:
+        sys.exit("pio not found, the benchmarks need PlatformIO's avr-gcc to build")
+
+
+def elf_path(env):
+    return os.path.join(ROOT, ".pio", "build", env, "firmware.elf")
+
+
+def run_simavr(simavr, elf, mcu, freq, timeout, sizes=None, pixels=None):
+    """Returns {name: cycles} in the order the firmware reported them.
+    The bus bytes of display transfers go into sizes, their pixel counts
+    into pixels, when given."""
+    if not os.path.exists(elf):
+        sys.exit("%s not built, run with --build" % os.path.relpath(elf, ROOT))
+    try:
+        proc = subprocess.Popen([simavr, "-m", mcu, "-f", str(freq), elf],
+                                stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                                universal_newlines=True)
+    except FileNotFoundError:
+        sys.exit("%s not found, install simavr or pass --simavr" % simavr)
+    results = {}
+    try:
+        out, _ = proc.communicate(timeout=timeout)
+    except subprocess.TimeoutExpired:
+        proc.kill()
+        out, _ = proc.communicate()
+    # simavr echoes UART lines wrapped in colour codes, match anywhere in the line
+    for line in out.splitlines():
+        if "B done" in line:
+            return results
+        m = LINE.search(ANSI.sub("", line))
+        if m and m.group(1) == "B":
+            results[m.group(2)] = int(m.group(3))
+        elif m and m.group(1) == "N" and sizes is not None:
+            sizes[m.group(2)] = int(m.group(3))
+        elif m and m.group(1) == "P" and pixels is not None:
+            pixels[m.group(2)] = int(m.group(3))
+    sys.exit("simavr output ended before 'B done':\n" + out[-2000:])
+
+
+def read_baseline(path):
+    base = {}
+    with open(path) as f:
+        for line in f:
+            line = line.split("#", 1)[0].split()
+            if len(line) == 2:
+                base[line[0]] = int(line[1])
+    return base
+
+
+def write_baseline(path, results, mcu, freq):
+    with open(path, "w") as f:
+        f.write("# cycles per call, simavr -m %s -f %d, written by scripts/avr_bench.py --update\n" % (mcu, freq))
+        for name, cycles in results.items():
+            f.write("%-24s %d\n" % (name, cycles))
+
+
+def compare(results, base, threshold):
+    failed = False
+    print("%-24s %10s %10s %8s" % ("benchmark", "baseline", "cycles", "change"))
+    for name, cycles in results.items():
+        if name not in base:
+            print("%-24s %10s %10d %8s" % (name, "-", cycles, "new"))
+            continue
+        change = 100.0 * (cycles - base[name]) / max(base[name], 1)
+        flag = ""
+        if change > threshold:
+            flag = "  REGRESSED"
+            failed = True
+        print("%-24s %10d %10d %+7.1f%%%s" % (name, base[name], cycles, change, flag))
+    for name in base:
+        if name not in results:
+            print("%-24s %10d %10s %8s" % (name, base[name], "-", "missing"))
+            failed = True
+    return not failed
+
+
+def compare_buses(args):
+    """Runs both displayBus.h backends and prints bytes/s for every display transfer."""
+    envs = [("spi", "avrbench"), ("mspim", "avrbench_mspim")]
+    cycles, sizes = {}, {}
+    for bus, env in envs:
+        if args.build:
+            build(env)
+        cycles[bus] = run_simavr(args.simavr, elf_path(env), args.mcu, args.freq, args.timeout, sizes)
+    print("%-24s %8s %12s %12s %8s" % ("transfer", "bytes", "spi B/s", "mspim B/s", "gain"))
+    for name, size in sizes.items():
+        rate = {bus: size * args.freq / max(cycles[bus].get(name, 0), 1) for bus, _ in envs}
+        print("%-24s %8d %12.0f %12.0f %7.2fx" % (name, size, rate["spi"], rate["mspim"], rate["mspim"] / rate["spi"]))
+    return 0
+
+
+def per_pixel(args):
+    """Cycles per pixel of every transfer that reported its pixel count."""
+    if args.build:
+        build()
+    pixels = {}
+    cycles = run_simavr(args.simavr, args.elf, args.mcu, args.freq, args.timeout, pixels=pixels)
+    print("%-24s %8s %10s %10s" % ("transfer", "pixels", "cycles", "per pixel"))
+    for name, count in pixels.items():
+        print("%-24s %8d %10d %10.1f" % (name, count, cycles[name], cycles[name] / count))
+    return 0
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--build", action="store_true", help="run pio run -e avrbench first")
+    ap.add_argument("--update", action="store_true", help="write the results as the new baseline")
+    ap.add_argument("--compare", action="store_true", help="bytes/s of the display transfers on both bus backends")
+    ap.add_argument("--per-pixel", action="store_true", help="cycles per pixel of the sprite, image and fill transfers")
+    ap.add_argument("--elf", default=elf_path("avrbench"))
+    ap.add_argument("--baseline", default=os.path.join(ROOT, "scripts", "avr_bench.baseline"))
+    ap.add_argument("--threshold", type=float, default=2.0, help="allowed slowdown in percent")
+    ap.add_argument("--simavr", default="simavr")
+    ap.add_argument("--mcu", default="atmega328p")
+    ap.add_argument("--freq", type=int, default=16000000)
+    ap.add_argument("--timeout", type=float, default=120.0, help="seconds of wall time for simavr")
+    args = ap.parse_args()
+
+    if args.compare:
+        return compare_buses(args)
+    if args.per_pixel:
+        return per_pixel(args)
+    if args.build:
+        build()
+    results = run_simavr(args.simavr, args.elf, args.mcu, args.freq, args.timeout)
+
+    if not args.update and not os.path.exists(args.baseline):
+        # nothing to compare against is a skip, not a pass: the run says so and
+        # writes nothing, a baseline only comes from --update
+        for name, cycles in results.items():
+            print("%-24s %10d" % (name, cycles))
+        print("SKIP: no baseline at %s, regression check not run. Check these numbers "
+              "and record them with --update" % os.path.relpath(args.baseline, ROOT))
+        return 0
+    if args.update:
+        write_baseline(args.baseline, results, args.mcu, args.freq)
+        for name, cycles in results.items():
+            print("%-24s %10d" % (name, cycles))
+        print("baseline written to %s" % os.path.relpath(args.baseline, ROOT))
+        return 0
+
+    return 0 if compare(results, read_baseline(args.baseline), args.threshold) else 1
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,135 @@
+#!/usr/bin/env python3
+"""RAM and flash budget of an AVR build, by section and by symbol.
+
+Reads the firmware ELF's section headers and symbol table and prints what
+the build takes of the part's flash and SRAM, the stack's share of what is
+left, and the biggest SRAM symbols. Runs as a PlatformIO post: script after
+every AVR build (env:part1 and everything extending it), and on its own:
+
+    python3 scripts/budget_report.py .pio/build/uno/firmware.elf --mcu atmega328p
+    python3 scripts/budget_report.py .pio/build/rich/firmware.elf --mcu atmega1284p --top 20
+
+flash is .text plus .data (the initial values are copied from flash at
+boot), SRAM is .data, .bss and .noinit. Only the standard library is used.
+"""
+import argparse
+import struct
+import sys
+
+# flash without the bootloader, SRAM
+PARTS = {
+    "atmega328p": (32256, 2048),
+    "atmega1284p": (130048, 16384),
+    "atmega1284": (130048, 16384),
+}
+RAM_SECTIONS = (".data", ".bss", ".noinit")
+FLASH_SECTIONS = (".text", ".data")
+STACK_MIN = 256  # fewer bytes left than this for the stack is flagged, stackPaint.h measures the real need
+TIERS = ("FEATURES_LEAN", "FEATURES_RICH")
+
+
+def read_elf(path):
+    """Returns ({section: size}, [(symbol, section, size)]) for the allocated sections."""
+    with open(path, "rb") as f:
+        data = f.read()
+    if data[:4] != b"\x7fELF":
+        raise ValueError("%s: not an ELF file" % path)
+    wide = data[4] == 2
+    end = "<" if data[5] == 1 else ">"
+    if wide:
+        shoff, = struct.unpack_from(end + "Q", data, 0x28)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", data, 0x3A)
+        shdr = end + "IIQQQQIIQQ"
+    else:
+        shoff, = struct.unpack_from(end + "I", data, 0x20)
+        shentsize, shnum, shstrndx = struct.unpack_from(end + "HHH", data, 0x2E)
+        shdr = end + "IIIIIIIIII"
+
+    headers = [struct.unpack_from(shdr, data, shoff + i * shentsize) for i in range(shnum)]
+    names = headers[shstrndx]
+
+    def string(table, at):
+        start = table[4] + at
+        return data[start:data.index(b"\0", start)].decode("ascii", "replace")
+
+    sections, by_index = {}, {}
+    symtab = None
+    for i, h in enumerate(headers):
+        name = string(names, h[0])
+        by_index[i] = name
+        if h[1] == 2:  # SHT_SYMTAB
+            symtab = h
+        if h[2] & 0x2:  # SHF_ALLOC
+            sections[name] = sections.get(name, 0) + h[5]
+
+    symbols = []
+    if symtab is not None:
+        strtab = headers[symtab[6]]
+        for at in range(symtab[4], symtab[4] + symtab[5], symtab[9]):
+            if wide:
+                st_name, st_info, _, st_shndx, _, st_size = struct.unpack_from(end + "IBBHQQ", data, at)
+            else:
+                st_name, _, st_size, st_info, _, st_shndx = struct.unpack_from(end + "IIIBBH", data, at)
+            if (st_info & 0x0F) == 1 and st_size > 0 and st_shndx in by_index:  # STT_OBJECT
+                symbols.append((string(strtab, st_name), by_index[st_shndx], st_size))
+    return sections, symbols
+
+
+def report(elf, mcu, tier="default", top=10, out=sys.stdout):
+    """Prints the budget, returns the bytes left for the stack."""
+    sections, symbols = read_elf(elf)
+    flash_max, ram_max = PARTS.get(mcu.lower(), (0, 0))
+    flash = sum(sections.get(s, 0) for s in FLASH_SECTIONS)
+    ram = sum(sections.get(s, 0) for s in RAM_SECTIONS)
+
+    def share(used, limit):
+        return "%6d / %6d %5.1f%%" % (used, limit, 100.0 * used / limit) if limit else "%6d" % used
+
+    out.write("budget %s, %s\n" % (mcu, tier))
+    out.write("  flash %s   %s\n" % (share(flash, flash_max),
+                                     " ".join("%s %d" % (s, sections.get(s, 0)) for s in FLASH_SECTIONS)))
+    out.write("  sram  %s   %s\n" % (share(ram, ram_max),
+                                     " ".join("%s %d" % (s, sections.get(s, 0)) for s in RAM_SECTIONS)))
+    left = ram_max - ram
+    if ram_max:
+        out.write("  stack %6d bytes left%s\n" % (left, "" if left >= STACK_MIN else
+                                                   ", under %d, check 'm' (stackPaint.h)" % STACK_MIN))
+    held = sorted((s for s in symbols if s[1] in RAM_SECTIONS), key=lambda s: (-s[2], s[0]))
+    for name, section, size in held[:top]:
+        out.write("    %-28s %-8s %6d\n" % (name, section, size))
+    return left
+
+
+def build_tier(defines):
+    """The FEATURES_ tier among PlatformIO's CPPDEFINES, strings or (name, value) pairs."""
+    for d in defines:
+        name = d[0] if isinstance(d, (tuple, list)) else str(d)
+        if name in TIERS:
+            return name
+    return "default"
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("elf")
+    ap.add_argument("--mcu", default="atmega328p", help="one of " + ", ".join(sorted(PARTS)))
+    ap.add_argument("--tier", default="default", help="name printed in the header line")
+    ap.add_argument("--top", type=int, default=10, help="SRAM symbols listed")
+    args = ap.parse_args()
+    try:
+        report(args.elf, args.mcu, args.tier, args.top)
+    except (OSError, ValueError) as e:
+        sys.exit(str(e))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
+elif "Import" in globals():
+    # PlatformIO extra_scripts = post:scripts/budget_report.py, __file__ is not set under SCons
+    Import("env")  # noqa: F821
+
+    def _after_link(source, target, env):
+        report(str(target[0]), env.BoardConfig().get("build.mcu"), build_tier(env.get("CPPDEFINES", [])))
+
+    env.AddPostAction("$BUILD_DIR/${PROGNAME}.elf", _after_link)  # noqa: F821
@@ -0,0 +1,112 @@
+#!/usr/bin/env python3
+"""Runs the env:deadline_test firmware under simavr and checks the watchdog recovery.
+
+That build hangs TickDraw once at scheduler tick DEADLINE_HANG_TICK (50) with
+interrupts off. The watchdog has to reset the board, and the second boot has to
+report the hang over the UART and resume:
+
+    boot                     first boot
+    ...
+    W watchdog               after the reset, MCUSR had WDRF
+    W task 5                 the .noinit record: TickDraw
+    W tick 50
+    W resumed                back on the paused screen of the kept game
+    boot
+
+    python3 scripts/deadline_check.py --build
+
+--log checks a UART capture instead of running simavr, host_sim deadline writes
+one from the .noinit record of its own hang (which is not at tick 50):
+
+    host_sim deadline 3 w.log
+    python3 scripts/deadline_check.py --log w.log --tick 307
+"""
+import argparse
+import os
+import re
+import select
+import subprocess
+import sys
+import time
+
+ROOT = os.path.dirname(os.path.dirname(os.path.abspath(__file__)))
+ANSI = re.compile(r"\x1b\[[0-9;]*m")
+HANG_TASK = 5
+HANG_TICK = 50
+
+
+def run(args):
+    """UART lines up to the line after the report, or until the timeout."""
+    proc = subprocess.Popen([args.simavr, "-m", args.mcu, "-f", str(args.freq), args.elf],
+                            stdout=subprocess.PIPE, stderr=subprocess.STDOUT,
+                            universal_newlines=True, bufsize=1)
+    lines, end = [], time.time() + args.timeout
+    try:
+        while time.time() < end:
+            ready, _, _ = select.select([proc.stdout], [], [], 0.5)
+            if not ready:
+                continue
+            line = proc.stdout.readline()
+            if not line:
+                break
+            lines.append(ANSI.sub("", line).strip())
+            if any(s in lines[-1] for s in ("W resumed", "W lost")):
+                break
+    finally:
+        proc.kill()
+        proc.wait()
+    return lines
+
+
+def read_log(path):
+    """UART lines from a capture, simavr's or host_sim deadline's."""
+    with open(path) as f:
+        return [ANSI.sub("", line).strip() for line in f]
+
+
+def value(lines, key):
+    for line in lines:
+        m = re.search(r"W %s (\d+)" % key, line)
+        if m:
+            return int(m.group(1))
+    return None
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("--build", action="store_true", help="run pio run -e deadline_test first")
+    ap.add_argument("--elf", default=os.path.join(ROOT, ".pio", "build", "deadline_test", "firmware.elf"))
+    ap.add_argument("--simavr", default="simavr")
+    ap.add_argument("--mcu", default="atmega328p")
+    ap.add_argument("--freq", type=int, default=16000000)
+    ap.add_argument("--timeout", type=float, default=120.0, help="seconds of wall time for simavr")
+    ap.add_argument("--log", help="check this UART capture, simavr is not run")
+    ap.add_argument("--task", type=int, default=HANG_TASK, help="task the report has to name")
+    ap.add_argument("--tick", type=int, default=HANG_TICK, help="tick the report has to name")
+    args = ap.parse_args()
+
+    if args.log:
+        try:
+            lines = read_log(args.log)
+        except OSError as e:
+            sys.exit(str(e))
+    else:
+        if args.build:
+            subprocess.run(["pio", "run", "-e", "deadline_test"], cwd=ROOT, check=True)
+        lines = run(args)
+    tail = "\n".join(lines[-20:])
+
+    if not any("W watchdog" in line for line in lines):
+        sys.exit("no watchdog reset within %.0f s:\n%s" % (args.timeout, tail))
+    if value(lines, "task") is None:
+        sys.exit("the watchdog reset the board but the .noinit record did not survive:\n" + tail)
+    if (value(lines, "task"), value(lines, "tick")) != (args.task, args.tick):
+        sys.exit("expected task %d tick %d:\n%s" % (args.task, args.tick, tail))
+    if not any("W resumed" in line for line in lines):
+        sys.exit("the board did not resume the kept game:\n" + tail)
+    print("deadline ok: watchdog reset, task %d tick %d reported, resumed paused" % (args.task, args.tick))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
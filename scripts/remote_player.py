@@ -0,0 +1,77 @@
+#!/usr/bin/env python3
+"""Stand-in player for the remote.h command channel.
+
+Seeds a run, starts it with a control tap and then jumps on a fixed
+period so the same load can be replayed against a board or simavr.
+
+    python3 scripts/remote_player.py /dev/pts/3 --seed 7 --period 6 --jumps 200
+"""
+import argparse
+import os
+import termios
+import time
+
+
+def open_port(path, baud):
+    fd = os.open(path, os.O_RDWR | os.O_NOCTTY)
+    attrs = termios.tcgetattr(fd)
+    speed = getattr(termios, "B%d" % baud)
+    attrs[0] = 0                                            # iflag
+    attrs[1] = 0                                            # oflag
+    attrs[2] = termios.CS8 | termios.CREAD | termios.CLOCAL  # cflag
+    attrs[3] = 0                                            # lflag
+    attrs[4] = speed
+    attrs[5] = speed
+    termios.tcsetattr(fd, termios.TCSANOW, attrs)
+    return fd
+
+
+def send(fd, line):
+    os.write(fd, (line + "\n").encode())
+    time.sleep(0.02)  # 9600 baud, let the 32 byte RX ring drain
+
+
+def read_line(fd):
+    buf = b""
+    while not buf.endswith(b"\n"):
+        buf += os.read(fd, 1)
+    return buf.decode().strip()
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("port")
+    ap.add_argument("--baud", type=int, default=9600)
+    ap.add_argument("--seed", type=int, default=1)
+    ap.add_argument("--period", type=int, default=6, help="ticks between jumps")
+    ap.add_argument("--jumps", type=int, default=100)
+    args = ap.parse_args()
+
+    fd = open_port(args.port, args.baud)
+    send(fd, "p")                 # hold while we queue
+    send(fd, "s%d" % args.seed)   # seed + reset
+    send(fd, "t")
+    start = int(read_line(fd)) + 4
+
+    # tap control to leave the paused screen
+    send(fd, "c%d,1" % start)
+    send(fd, "c%d,0" % (start + 1))
+    send(fd, "g")
+
+    # the event queue holds 16 edges, keep a few jumps ahead of the game
+    tick = start + 2
+    for _ in range(args.jumps):
+        send(fd, "j%d,1" % tick)
+        send(fd, "j%d,0" % (tick + 1))
+        tick += args.period
+        while True:
+            send(fd, "t")
+            if int(read_line(fd)) + 4 * args.period > tick:
+                break
+            time.sleep(0.1)
+
+    send(fd, "x")
+
+
+if __name__ == "__main__":
+    main()
@@ -0,0 +1,153 @@
+#!/usr/bin/env python3
+"""Turns an eventTrace.h dump into Chrome trace JSON.
+
+The board answers the remote 'f' command with one line, "F" followed by six
+hex digits an event: the Timer1 count (4 us a count) and the event id with
+its begin/end bits. Open the output in chrome://tracing or ui.perfetto.dev.
+
+    python3 scripts/trace_to_chrome.py dump.txt -o trace.json
+    python3 scripts/trace_to_chrome.py --port /dev/pts/3 -o trace.json --last-frame
+
+The counts are 16 bits and wrap every 262 ms. Every scheduler cycle records
+events, so a step back is taken as one wrap. Ends whose begin was pushed
+out of the ring are dropped, spans still open at the dump end at its last
+event.
+"""
+import argparse
+import json
+import sys
+
+US_PER_COUNT = 4
+TRACE_B = 0x40
+TRACE_E = 0x80
+TRACE_ID_MASK = 0x3F
+TRACE_SCHED = 8
+
+# keep in step with enum TRACE_ID in include/eventTrace.h
+NAMES = {
+    0: ("TickButtons", "task"),
+    1: ("TickPosition", "task"),
+    2: ("TickDeath", "task"),
+    3: ("TickMenu", "task"),
+    4: ("TickLevel", "task"),
+    5: ("TickDraw", "task"),
+    8: ("TimerISR", "isr"),
+    9: ("spi", "bus"),
+    10: ("lcd", "bus"),
+    11: ("uart rx", "isr"),
+    12: ("sound step", "isr"),
+    13: ("eeprom", "isr"),
+}
+DRAW = 5
+
+
+def parse_dump(text):
+    """Returns [(count, id byte)] from the first F line in text."""
+    for line in text.splitlines():
+        line = line.strip()
+        if line.startswith("F"):
+            hexs = line[1:]
+            if len(hexs) % 6:
+                raise ValueError("F line is %d hex digits, not a multiple of 6" % len(hexs))
+            return [(int(hexs[i:i + 4], 16), int(hexs[i + 4:i + 6], 16)) for i in range(0, len(hexs), 6)]
+        if line.startswith("E notrace"):
+            raise ValueError("the firmware was built without EVENT_TRACE")
+    raise ValueError("no F line in the input")
+
+
+def to_chrome(events):
+    """Returns the Chrome trace event list, timestamps in us from the first event."""
+    out, stack, t, prev, rooted = [], [], 0, None, False
+    for count, byte in events:
+        if prev is not None:
+            t += ((count - prev) & 0xFFFF) * US_PER_COUNT
+        prev = count
+        ev_id = byte & TRACE_ID_MASK
+        name, cat = NAMES.get(ev_id, ("id %d" % ev_id, "other"))
+        ev = {"name": name, "cat": cat, "ts": t, "pid": 1, "tid": 1}
+        if byte & TRACE_B:
+            rooted = rooted or (not stack and ev_id == TRACE_SCHED)
+            stack.append(ev_id)
+            ev["ph"] = "B"
+        elif byte & TRACE_E:
+            if not stack and not rooted:
+                continue  # its begin was pushed out of the ring
+            if not stack or stack[-1] != ev_id:
+                raise ValueError("end of %s at %d us inside %s" % (name, t, stack and NAMES[stack[-1]][0]))
+            stack.pop()
+            ev["ph"] = "E"
+        else:
+            ev["ph"] = "i"
+            ev["s"] = "t"
+        out.append(ev)
+    for ev_id in reversed(stack):
+        name, cat = NAMES.get(ev_id, ("id %d" % ev_id, "other"))
+        out.append({"name": name, "cat": cat, "ts": t, "pid": 1, "tid": 1, "ph": "E"})
+    return out
+
+
+def last_frame(trace):
+    """The last whole TimerISR span with a TickDraw in it, and everything inside."""
+    begin, best, draw = None, None, False
+    for i, ev in enumerate(trace):
+        if ev["name"] == "TimerISR" and ev["ph"] == "B":
+            begin, draw = i, False
+        elif ev["name"] == NAMES[DRAW][0] and ev["ph"] == "B":
+            draw = True
+        elif ev["name"] == "TimerISR" and ev["ph"] == "E" and begin is not None and draw:
+            best = (begin, i)
+    if best is None:
+        raise ValueError("no whole scheduler cycle with a TickDraw in the dump")
+    return trace[best[0]:best[1] + 1]
+
+
+def read_port(path, baud):
+    from remote_player import open_port, read_line, send
+    import os
+    fd = open_port(path, baud)
+    try:
+        send(fd, "f")
+        while True:
+            line = read_line(fd)
+            if line.startswith("F") or line.startswith("E"):
+                return line
+    finally:
+        os.close(fd)
+
+
+def main():
+    ap = argparse.ArgumentParser()
+    ap.add_argument("dump", nargs="?", help="file with the F line, stdin if left out")
+    ap.add_argument("--port", help="serial device to send 'f' to instead")
+    ap.add_argument("--baud", type=int, default=9600)
+    ap.add_argument("-o", "--out", help="JSON file, stdout if left out")
+    ap.add_argument("--last-frame", action="store_true", help="only the last scheduler cycle that drew")
+    args = ap.parse_args()
+
+    try:
+        if args.port:
+            text = read_port(args.port, args.baud)
+        elif args.dump:
+            text = open(args.dump).read()
+        else:
+            text = sys.stdin.read()
+        trace = to_chrome(parse_dump(text))
+        if args.last_frame:
+            trace = last_frame(trace)
+    except ValueError as e:
+        sys.exit(str(e))
+
+    doc = json.dumps({"traceEvents": trace, "displayTimeUnit": "ms"}, indent=1)
+    if args.out:
+        with open(args.out, "w") as f:
+            f.write(doc + "\n")
+        spans = sum(1 for ev in trace if ev["ph"] == "B")
+        print("%d events, %d spans, %.1f ms" % (len(trace), spans, (trace[-1]["ts"] - trace[0]["ts"]) / 1000.0
+                                               if trace else 0.0))
+    else:
+        print(doc)
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
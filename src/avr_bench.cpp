@@ -0,0 +1,180 @@
+//CYCLE BENCHMARKS
+//runs the hot drivers and tick functions once each on a known game state and reports how many
+//CPU cycles they took over the UART, one "B <name> <cycles>" line each, then "B done"
+//built by env:avrbench and run under simavr by scripts/avr_bench.py, which keeps the baseline
+//
+//Timer1 runs at prescaler 1, so TCNT1 counts CPU cycles, its overflow interrupt extends it to
+//32 bits for the full-screen fills. simavr is deterministic, the same build gives the same counts.
+//the overflow ISR's own cycles land in the long measurements, a fixed cost per 65536 cycles
+//the scheduler timer is never started, so nothing else interrupts a measurement
+//
+//the display transfers also print "N <name> <bytes>", bytes on the bus, scripts/avr_bench.py
+//--compare turns them into bytes per second for each displayBus.h backend
+//pixel transfers add "P <name> <pixels>", --per-pixel divides cycles by them so a sprite blit
+//can be put next to a FillWindow of the same box
+//in env:avrbench_mspim USART0 is the display bus, each report borrows it back as a UART
+
+#include <avr/interrupt.h>
+#include <avr/io.h>
+#include <avr/sleep.h>
+#include "game.h"
+
+volatile uint16_t bench_overflows = 0;
+
+ISR(TIMER1_OVF_vect){
+  bench_overflows++;
+}
+
+unsigned long bench_overhead = 0; //cost of an empty start/stop pair
+
+void bench_timer_init(){
+  TCCR1A = 0x00;
+  TCCR1B = (1 << CS10); //normal mode, no prescaler
+  TIMSK1 = (1 << TOIE1);
+}
+
+void bench_start(){
+  cli();
+  bench_overflows = 0;
+  TIFR1 = (1 << TOV1);
+  TCNT1 = 0;
+  sei();
+}
+
+unsigned long bench_stop(){
+  uint16_t lo = TCNT1;
+  cli();
+  uint16_t hi = bench_overflows;
+  //overflow landed between the read and cli, its ISR has not run yet
+  if ((TIFR1 & (1 << TOV1)) && lo < 0x8000){
+    hi++;
+  }
+  sei();
+  return (((unsigned long)hi << 16) | lo) - bench_overhead;
+}
+
+//hands USART0 back to the console for a report and takes it again after
+void bench_console(bool on){
+#ifdef DISPLAY_BUS_MSPIM
+  if (on){
+    BUS_FLUSH();
+    UCSR0B = 0;
+    UCSR0C = 0;
+    serial_init(9600);
+    UCSR0A = (UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0); //sets again once the report has shifted out
+  }
+  else {
+    while (!(UCSR0A & (1 << TXC0)));
+    BUS_INIT();
+  }
+#endif
+}
+
+//name is in flash, the BENCH macros wrap it in PSTR
+void bench_line(char kind, const char *name, unsigned long value){
+  bench_console(true);
+  serial_report_P(kind, name, value);
+  bench_console(false);
+}
+
+void bench_report(const char *name, unsigned long cycles){
+  bench_line('B', name, cycles);
+}
+
+#define BENCH(name, stmt) do { bench_start(); stmt; unsigned long c_ = bench_stop(); bench_report(PSTR(name), c_); } while (0)
+
+//a display transfer, reports its bus bytes next to its cycles
+#define BENCH_BUS(name, bytes, stmt) do { BENCH(name, stmt); bench_line('N', PSTR(name), bytes); } while (0)
+
+//a display transfer of a known number of pixels
+#define BENCH_PIXELS(name, pixels, stmt) do { BENCH_BUS(name, TFT_PIXEL_BYTES(pixels) + 11, stmt); bench_line('P', PSTR(name), pixels); } while (0)
+
+//level 1, frame at the first pipe and the bird inside its gap, the state TickDeath and
+//draw_pipes see mid-run, TickDeath walks the whole window without dying
+void bench_game_state(){
+  rng_seed(1);
+  tasks_init();
+  create_level();
+  game_state = PLAY;
+  frame = PIPE_SPACING;
+  curr_column = &columns[PIPE_SPACING + 1];
+  height = columns[PIPE_SPACING].bottom + GAP / 2;
+  score = 12;
+}
+
+int main(void){
+  DDRB = 0xFF; PORTB = 0x00;
+  DDRC = 0x00; PORTC = 0xFF;
+  DDRD = 0xFF; PORTD = 0x00;
+
+  SPI_INIT();
+  ST7735_init();
+  serial_init(9600);
+#ifndef NO_LCD
+  lcd_init();
+#endif
+  bench_game_state();
+  bench_timer_init();
+
+  bench_start();
+  bench_overhead = bench_stop();
+
+  BENCH_BUS("SetWriteWindow_full", 11, SetWriteWindow(XS, YS, XE, YE));
+  BENCH_BUS("FillWindow_player", TFT_PIXEL_BYTES(11 * 11), FillWindow(26, 59, 36, 69, PLAYER_COLOR));
+  BENCH_BUS("FillWindow_pipe", TFT_PIXEL_BYTES(61), FillWindow(40, YS, 40, 60, PIPE_COLOR));
+  BENCH_BUS("FillWindow_full", TFT_PIXEL_BYTES(132UL * 132), FillWindow(XS, YS, XE, YE, BACKGROUND));
+  //same 11x5 box, the window command is inside the measurement for all three
+  BENCH_PIXELS("FillWindow_bird", 11 * 5, SetWriteWindow(26, 62, 36, 66); FillWindow(26, 62, 36, 66, PLAYER_COLOR));
+  BENCH_PIXELS("BlitSprite_bird", 11 * 5, BlitSprite(bird_glide, 26, 62, bird_palette));
+  BENCH("BlitSprite_bird_keyed", BlitSprite(bird_glide, 26, 62, bird_palette, SPRITE_KEYED));
+  BENCH_PIXELS("BlitSprite_cap", 4 * 2, BlitSprite(pipe_cap, 39, 60, pipe_palette));
+  //run length decode into the stream, the splash's short text runs against the backdrop's long ones
+  BENCH_PIXELS("DrawImage_background", 132UL * 132, DrawImage(asset_background, XS, YS));
+  BENCH_PIXELS("DrawImage_splash", ASSET_SPLASH_W * ASSET_SPLASH_H, DrawImage(asset_splash, 16, 41));
+  //one score digit from the run cache against the same glyph read bit by bit, and the LCD's write_score
+  BENCH_PIXELS("DrawDigit", FONT_COLS * FONT_ROWS, DrawDigit(8, 100, 100));
+  BENCH_PIXELS("DrawText_digit", FONT_COLS * FONT_ROWS, DrawText(100, 100, "8", PIPE_COLOR, BACKGROUND));
+  //Timer0 sound ISR body, one edge mid-note and one that loads the next step, plus the trigger
+  sound_init();
+  BENCH("sound_play", sound_play(SOUND_DEATH));
+  sound_left = 100;
+  BENCH("sound_edge", sound_edge());
+  sound_left = 1;
+  BENCH("sound_edge_step", sound_edge());
+  sound_stop();
+  BENCH("draw_player", draw_player());
+  BENCH("draw_pipes", draw_pipes());
+  BENCH("TickDeath", TickDeath(CHECK));
+  //four columns since the last check, the longest line the sweep walks
+  death_frame = frame - 4;
+  death_height = height - 3;
+  BENCH("TickDeath_swept", TickDeath(CHECK));
+  BENCH("TickPosition", TickPosition(FALLING));
+  BENCH("TickLevel", TickLevel(GO));
+  BENCH("write_score", write_score(12345, 0));
+  BENCH("EEPROM_read", EEPROM_read(EEPROM_SCORE_ADDR));
+  //the .noinit game copy, every DEADLINE_KEEP cycles, tick 0 is one of them
+  tick_count = 0;
+  BENCH("deadline_keep", deadline_keep());
+#ifdef EVENT_TRACE
+  //one event into the ring, what every TRACE_BEGIN/END/MARK costs
+  BENCH("trace_event", trace_event(TRACE_SPI | TRACE_B));
+#endif
+  //scan and repaint after a tick, top is this frame so it sees what the benches above left behind
+  uint8_t *top = stack_task_begin();
+  BENCH("stack_task_end", stack_task_end(0, top));
+  BENCH("stack_task_end_clean", stack_task_end(0, top));
+
+  bench_console(true);
+  UCSR0A = (UCSR0A & ((1 << U2X0) | (1 << MPCM0))) | (1 << TXC0); //write one to clear, sets again once the line below has shifted out
+  serial_println_P(PSTR("B done"));
+  while (!(UCSR0A & (1 << TXC0)));
+
+  //sleeping with interrupts off ends a simavr run
+  cli();
+  set_sleep_mode(SLEEP_MODE_PWR_DOWN);
+  sleep_enable();
+  sleep_cpu();
+  while (1);
+  return 0;
+}
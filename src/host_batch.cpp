@@ -0,0 +1,168 @@
+//BATCHED ENVIRONMENT TOOL
+//
+//  host_batch bench [steps]       env steps per second at batch sizes 1, 64 and 4096
+//  host_batch check [seeds]       plays the scalar core per seed, replays its buttons into one
+//                                 lane per seed, fails on the first tick they disagree
+
+#include "sim.h"
+#include "batch_env.h"
+#include <chrono>
+#include <ctype.h>
+
+double batch_seconds(){
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+//button slips for check, xorshift so it never touches the game's PRNG
+uint32_t batch_noise(uint32_t *x){
+    *x ^= *x << 13;
+    *x ^= *x >> 17;
+    *x ^= *x << 5;
+    return *x;
+}
+
+int check(unsigned long seeds){
+    const unsigned long max_steps = 4000;
+    std::vector<std::vector<int32_t>> actions(max_steps, std::vector<int32_t>(seeds, 0));
+    std::vector<int32_t> core_height(max_steps * seeds), core_score(max_steps * seeds);
+    std::vector<unsigned long> core_end(seeds);
+    unsigned long ticks = 0, score_sum = 0;
+
+    //the core plays each seed with the autopilot plus slips and long holds, so runs get far
+    //enough to refresh pipes, and its buttons are kept for the lanes
+    for (unsigned long k = 0; k < seeds; k++){
+        uint32_t x = 2463534242u + k;
+        int hold = 0, level = 0;
+        sim_reset(k + 1);
+        sim_start();
+        unsigned long t = 0;
+        for (; t < max_steps; t++){
+            bool autopilot = sim_autopilot();
+            if (hold > 0){
+                hold--;
+            }
+            else if (batch_noise(&x) % 128 == 0){
+                level = !autopilot;
+                hold = batch_noise(&x) % 4;
+            }
+            else {
+                level = autopilot;
+            }
+            actions[t][k] = level;
+            sim_buttons(false, level);
+            sim_tick();
+            ticks++;
+            bool died = sim_died();
+            core_height[t * seeds + k] = height;
+            core_score[t * seeds + k] = died ? sim_last_score : score;
+            if (died){
+                score_sum += sim_last_score;
+                break;
+            }
+        }
+        core_end[k] = t; //death step, max_steps if the run survived
+    }
+
+    struct batch_env env;
+    batch_init(&env, seeds);
+    for (unsigned long k = 0; k < seeds; k++){
+        batch_reset(&env, k, k + 1);
+    }
+    for (unsigned long t = 0; t < max_steps; t++){
+        batch_step(&env, actions[t].data());
+        for (unsigned long k = 0; k < seeds; k++){
+            unsigned long at = t * seeds + k;
+            if (t > core_end[k]){
+                continue;
+            }
+            bool died = t == core_end[k];
+            if (env.height[k] != core_height[at] || env.score[k] != core_score[at] || (env.done[k] != 0) != died){
+                printf("seed %lu step %lu: core height %d score %d dead %d, batch height %d score %d dead %d\n",
+                    k + 1, t, core_height[at], core_score[at], died, env.height[k], env.score[k], env.done[k]);
+                return 1;
+            }
+        }
+    }
+    printf("check ok: %lu seeds, %lu ticks, mean score %.2f\n", seeds, ticks, (double)score_sum / seeds);
+    return 0;
+}
+
+//a vectorizable autopilot on the observations: tap while below the middle of the next gap
+void bench_policy(const float *obs, int32_t *act, int32_t *pressed, int n){
+    const float *h = &obs[BATCH_OBS_HEIGHT * n];
+    const float *lo = &obs[BATCH_OBS_BOTTOM * n];
+    const float *hi = &obs[BATCH_OBS_TOP * n];
+    for (int k = 0; k < n; k++){
+        int32_t want = h[k] < (lo[k] + hi[k]) * 0.5f;
+        act[k] = want & !pressed[k];
+        pressed[k] = act[k];
+    }
+}
+
+void bench_batch(int n, unsigned long total_steps){
+    struct batch_env env;
+    batch_init(&env, n);
+    std::vector<float> obs(BATCH_OBS * n);
+    std::vector<int32_t> act(n), pressed(n);
+    unsigned long next_seed = 1, episodes = 0;
+    for (int k = 0; k < n; k++){
+        batch_reset(&env, k, next_seed++);
+    }
+
+    unsigned long rounds = total_steps / n + 1;
+    double t0 = batch_seconds();
+    for (unsigned long r = 0; r < rounds; r++){
+        batch_observe(&env, obs.data());
+        bench_policy(obs.data(), act.data(), pressed.data(), n);
+        batch_step(&env, act.data());
+        for (int k = 0; k < n; k++){
+            if (env.done[k]){
+                batch_reset(&env, k, next_seed++);
+                pressed[k] = 0;
+                episodes++;
+            }
+        }
+    }
+    double dt = batch_seconds() - t0;
+    double steps = (double)rounds * n;
+    printf("batch %5d  %10.0f env steps/s  (%.1f ns/step, %lu episodes)\n", n, steps / dt, dt * 1e9 / steps, episodes);
+}
+
+//the full core for scale, one scheduler cycle is one env step
+void bench_scalar(unsigned long total_steps){
+    unsigned long start = tick_count;
+    double t0 = batch_seconds();
+    while (tick_count - start < total_steps){
+        sim_reset(tick_count);
+        sim_play(total_steps - (tick_count - start));
+    }
+    double dt = batch_seconds() - t0;
+    printf("core       %10.0f ticks/s      (%.1f ns/tick, game.h through sim.h)\n",
+        (tick_count - start) / dt, dt * 1e9 / (tick_count - start));
+}
+
+int main(int argc, char **argv){
+    if (argc < 2){
+        fprintf(stderr, "usage: %s bench [steps] | check [seeds]\n", argv[0]);
+        return 2;
+    }
+    host_render = false;
+    sim_boot(1);
+
+    unsigned long arg = (argc > 2 && isdigit(argv[2][0])) ? strtoul(argv[2], NULL, 10) : 0;
+    if (!strcmp(argv[1], "bench")){
+        unsigned long steps = arg ? arg : 50000000UL;
+        bench_scalar(steps / 10);
+        int sizes[] = {1, 64, 4096};
+        for (int n : sizes){
+            bench_batch(n, steps);
+        }
+        return 0;
+    }
+    if (!strcmp(argv[1], "check")){
+        return check(arg ? arg : 500);
+    }
+    fprintf(stderr, "unknown command %s\n", argv[1]);
+    return 2;
+}
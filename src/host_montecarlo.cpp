@@ -0,0 +1,415 @@
+//MONTE CARLO DIFFICULTY ANALYZER
+//plays the game core across many seeds with a noisy autopilot, spread over a work-stealing
+//pool, and reports how long runs survive, what they score and how often the level generator
+//deals a pipe pair no input can get through
+//
+//  host_montecarlo [--seeds N] [--first S] [--ticks T] [--threads N] [--noise P] [--delay D]
+//  host_montecarlo --scaling [...]     same workload at 1, 2, 4 .. --threads threads
+//
+//every run depends only on its seed, results land in a per-seed slot and are summarised in
+//seed order, so the report (and its digest line) is the same for any thread count
+//build with -D overrides (GAP, PIPE_SPACING, GAP_MIN/GAP_MAX, FALL_ACCEL ..) to compare tunings
+
+#include "sim.h"
+#include "work_pool.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <ctype.h>
+
+#define MC_MAX_SPEED 129 //falling this fast leaves the screen in one tick
+#define MC_MAX_DELAY 16
+
+struct mc_result {
+    unsigned long survival;  //ticks from leaving the paused screen to death, or the tick limit
+    int score;
+    bool alive;              //still flying at the tick limit
+    unsigned int pairs;      //pipe to pipe transitions met
+    unsigned int impossible; //of those, how many no input sequence survives
+};
+
+struct mc_options {
+    unsigned long seeds = 2000;
+    unsigned long first = 1;
+    unsigned long ticks = 5000;
+    unsigned int threads = std::thread::hardware_concurrency();
+    double noise = 0.02;     //chance per tick the policy does the opposite of what it wants
+    unsigned int delay = 0;  //ticks between what the policy sees and what it presses
+    bool scaling = false;
+};
+
+double mc_seconds(){
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+
+
+//IMPOSSIBLE TRANSITIONS
+//whether a pipe with bottom b can be passed after a pipe with bottom a is a property of the
+//two heights and the physics, not of the run, so it is solved once per pair and cached
+//
+//the bird enters a's collision window anywhere in a's safe band, in any falling or jumping
+//state, then every tap/no-tap sequence is expanded one tick at a time the way TickButtons,
+//TickPosition and TickDeath see it, until b's window is behind it
+//no surviving state means the pair is impossible however well a was flown
+
+#define MC_RANGE (GAP_MAX - GAP_MIN + 1)
+
+std::atomic<signed char> mc_pair_cache[MC_RANGE][MC_RANGE]; //-1 unsolved, 0 possible, 1 impossible
+
+struct mc_state {
+    int16_t h;
+    uint8_t mode;    //0 .. MC_MAX_SPEED - 1 falling at that speed, MC_MAX_SPEED + cnt jumping
+    uint8_t pressed; //jump was down last tick, a new press needs a release first
+};
+
+bool mc_safe(int h, int f, int a, int b){
+    if (h < 0 || 128 < h){
+        return false;
+    }
+    //TickDeath checks every column within PLAYER_SIZE/2 of the frame, a sits at 0, b at PIPE_SPACING
+    int bottoms[2] = {a, b};
+    int cols[2] = {0, PIPE_SPACING};
+    for (int k = 0; k < 2; k++){
+        if (abs(f - cols[k]) <= PLAYER_SIZE/2 &&
+            (h - PLAYER_SIZE/4 + 1 < bottoms[k] || bottoms[k] + GAP < h + PLAYER_SIZE/4)){
+            return false;
+        }
+    }
+    return true;
+}
+
+//one TickPosition step with game_state == PLAY, false if the state falls off the table
+bool mc_step(struct mc_state *s, bool jump){
+    const int hangtime = JUMP_HANGTIME;
+    int speed = (s->mode < MC_MAX_SPEED) ? s->mode : 0;
+    int cnt = (s->mode < MC_MAX_SPEED) ? 0 : s->mode - MC_MAX_SPEED;
+    bool jumping = s->mode >= MC_MAX_SPEED;
+
+    //transitions
+    if (!jumping){
+        jumping = jump;
+    }
+    else if (cnt < hangtime){
+        cnt = jump ? 0 : cnt;
+    }
+    else {
+        speed = 0;
+        cnt = 0;
+        jumping = false;
+    }
+
+    //actions
+    if (jumping){
+        cnt++;
+        s->h += JUMP_VERTICAL;
+        s->mode = MC_MAX_SPEED + cnt;
+    }
+    else {
+        speed += FALL_ACCEL;
+        s->h -= speed;
+        if (speed >= MC_MAX_SPEED){
+            return false;
+        }
+        s->mode = speed;
+    }
+    s->pressed = jump;
+    return true;
+}
+
+bool mc_solve_pair(int a, int b){
+    const int modes = MC_MAX_SPEED + JUMP_HANGTIME + 1;
+    const int f0 = -PLAYER_SIZE/2;
+    std::vector<uint8_t> seen(129 * modes * 2);
+    std::vector<struct mc_state> cur, next;
+
+    for (int h = 0; h <= 128; h++){
+        if (!mc_safe(h, f0, a, b)){
+            continue;
+        }
+        for (int m = 0; m < modes; m++){
+            if (m != MC_MAX_SPEED){ //jumping with cnt 0 does not exist
+                cur.push_back(mc_state{(int16_t)h, (uint8_t)m, 0});
+                cur.push_back(mc_state{(int16_t)h, (uint8_t)m, 1});
+            }
+        }
+    }
+
+    //TickDeath sees the frame TickLevel left on the tick before, one column per tick
+    for (int f = f0 + 1; f <= PIPE_SPACING + PLAYER_SIZE/2 && !cur.empty(); f++){
+        std::fill(seen.begin(), seen.end(), 0);
+        next.clear();
+        for (const struct mc_state &s : cur){
+            for (int press = 0; press < 2; press++){
+                if (press && s.pressed){
+                    continue;
+                }
+                struct mc_state n = s;
+                if (!mc_step(&n, press) || !mc_safe(n.h, f, a, b)){
+                    continue;
+                }
+                uint8_t &mark = seen[(n.h * modes + n.mode) * 2 + n.pressed];
+                if (!mark){
+                    mark = 1;
+                    next.push_back(n);
+                }
+            }
+        }
+        cur.swap(next);
+    }
+    return cur.empty();
+}
+
+bool mc_impossible(int a, int b){
+    std::atomic<signed char> &slot = mc_pair_cache[a - GAP_MIN][b - GAP_MIN];
+    signed char known = slot.load(std::memory_order_relaxed);
+    if (known < 0){
+        known = mc_solve_pair(a, b); //two threads may race to the same answer, either store is fine
+        slot.store(known, std::memory_order_relaxed);
+    }
+    return known;
+}
+
+
+
+//NOISY AUTOPILOT
+//the sim.h autopilot with a reaction delay and random slips, driven by its own generator
+//seeded from the run's seed so the game's rng_next sequence is left alone
+
+struct mc_policy_state {
+    uint64_t rng;
+    double noise;
+    unsigned int delay;
+    bool want[MC_MAX_DELAY];
+    unsigned int pos;
+    bool pressed;
+};
+
+GAME_LOCAL struct mc_policy_state mc_policy;
+
+uint64_t mc_splitmix(uint64_t *x){
+    uint64_t z = (*x += 0x9E3779B97F4A7C15ULL);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+    return z ^ (z >> 31);
+}
+
+void mc_policy_reset(unsigned long seed, const struct mc_options *opt){
+    mc_policy.rng = seed;
+    mc_splitmix(&mc_policy.rng);
+    mc_policy.noise = opt->noise;
+    mc_policy.delay = opt->delay < MC_MAX_DELAY ? opt->delay : MC_MAX_DELAY - 1;
+    memset(mc_policy.want, 0, sizeof(mc_policy.want));
+    mc_policy.pos = 0;
+    mc_policy.pressed = false;
+}
+
+bool mc_noisy_autopilot(){
+    int pipe = sim_next_pipe();
+    int target = (pipe < 0) ? START_HEIGHT : columns[pipe].bottom + columns[pipe].gap / 2;
+
+    //what the policy decided delay ticks ago is what reaches the button now
+    mc_policy.want[(mc_policy.pos + mc_policy.delay) % MC_MAX_DELAY] = height < target;
+    bool want = mc_policy.want[mc_policy.pos];
+    mc_policy.pos = (mc_policy.pos + 1) % MC_MAX_DELAY;
+
+    if ((mc_splitmix(&mc_policy.rng) >> 11) * (1.0 / 9007199254740992.0) < mc_policy.noise){
+        want = !want;
+    }
+    mc_policy.pressed = !mc_policy.pressed && want;
+    return mc_policy.pressed;
+}
+
+
+
+//RUNS
+
+//pipe entering the collision window ahead of the bird this tick, -1 if none
+int mc_pipe_entering(){
+    int i = (frame + PLAYER_SIZE/2) % LEVEL_SIZE;
+    return columns[i].has_pipe ? i : -1;
+}
+
+struct mc_result mc_run(unsigned long seed, const struct mc_options *opt){
+    struct mc_result r = {0, 0, false, 0, 0};
+    sim_reset(seed);
+    mc_policy_reset(seed, opt);
+    sim_start();
+
+    unsigned long start = tick_count;
+    int last_bottom = -1;
+    int last_frame = -1;
+    while (tick_count - start < opt->ticks){
+        sim_buttons(false, mc_noisy_autopilot());
+        sim_tick();
+
+        //pipe bottoms are read as they come into range, refresh_pipe only touches pipes behind
+        int pipe = mc_pipe_entering();
+        if (pipe >= 0 && frame != last_frame){
+            int bottom = columns[pipe].bottom;
+            if (last_bottom >= 0){
+                r.pairs++;
+                r.impossible += mc_impossible(last_bottom, bottom);
+            }
+            last_bottom = bottom;
+        }
+        last_frame = frame;
+
+        if (sim_died()){
+            r.score = sim_last_score;
+            break;
+        }
+    }
+    r.survival = tick_count - start;
+    r.alive = !sim_died();
+    if (r.alive){
+        r.score = score;
+    }
+    sim_buttons(false, false);
+    return r;
+}
+
+//runs every seed, results[k] belongs to seed first + k whichever worker ran it
+double mc_batch(const struct mc_options *opt, unsigned int threads, std::vector<struct mc_result> *results){
+    results->assign(opt->seeds, mc_result{0, 0, false, 0, 0});
+    unsigned long grain = opt->seeds / (threads * 16) + 1; //enough chunks per worker to even out long runs
+
+    double t0 = mc_seconds();
+    work_run(opt->seeds, grain, threads,
+        [](unsigned int){
+            host_render = false;
+            sim_boot(1);
+        },
+        [&](unsigned long k){
+            (*results)[k] = mc_run(opt->first + k, opt);
+        });
+    return mc_seconds() - t0;
+}
+
+
+
+//REPORT
+
+template <typename T>
+T mc_percentile(std::vector<T> v, double p){
+    if (v.empty()){
+        return T();
+    }
+    std::sort(v.begin(), v.end());
+    size_t k = (size_t)(p * (v.size() - 1) + 0.5);
+    return v[k];
+}
+
+template <typename T>
+void mc_print_distribution(const char *name, const std::vector<T> &v){
+    double sum = 0;
+    for (T x : v){
+        sum += x;
+    }
+    printf("%-10s mean %8.1f  p10 %6ld  p50 %6ld  p90 %6ld  p99 %6ld  max %6ld\n", name,
+        v.empty() ? 0.0 : sum / v.size(), (long)mc_percentile(v, 0.10), (long)mc_percentile(v, 0.50),
+        (long)mc_percentile(v, 0.90), (long)mc_percentile(v, 0.99), (long)mc_percentile(v, 1.0));
+}
+
+void mc_report(const struct mc_options *opt, const std::vector<struct mc_result> &results){
+    std::vector<unsigned long> survival;
+    std::vector<int> scores, impossible;
+    unsigned long alive = 0, pairs = 0, bad = 0, runs_with_bad = 0;
+    uint64_t digest = 0xCBF29CE484222325ULL; //FNV-1a over the per-seed results, in seed order
+
+    for (const struct mc_result &r : results){
+        survival.push_back(r.survival);
+        scores.push_back(r.score);
+        impossible.push_back(r.impossible);
+        alive += r.alive;
+        pairs += r.pairs;
+        bad += r.impossible;
+        runs_with_bad += r.impossible > 0;
+        unsigned long fields[3] = {r.survival, (unsigned long)r.score, r.impossible};
+        for (unsigned long x : fields){
+            digest = (digest ^ x) * 0x100000001B3ULL;
+        }
+    }
+
+    printf("seeds %lu..%lu ticks %lu noise %.3f delay %u\n", opt->first, opt->first + opt->seeds - 1,
+        opt->ticks, opt->noise, opt->delay);
+    printf("tunables GAP %d PIPE_SPACING %d GAP_MIN %d GAP_MAX %d FALL_ACCEL %d JUMP_VERTICAL %d JUMP_HANGTIME %d\n",
+        GAP, PIPE_SPACING, GAP_MIN, GAP_MAX, FALL_ACCEL, JUMP_VERTICAL, JUMP_HANGTIME);
+    mc_print_distribution("survival", survival);
+    mc_print_distribution("score", scores);
+    mc_print_distribution("impossible", impossible);
+    printf("alive_at_limit %lu (%.1f%%)\n", alive, 100.0 * alive / results.size());
+    printf("pipe_pairs %lu impossible %lu (%.3f%%) runs_dealt_one %lu\n", pairs, bad,
+        pairs ? 100.0 * bad / pairs : 0.0, runs_with_bad);
+
+    unsigned long solved = 0, hard = 0;
+    for (int a = 0; a < MC_RANGE; a++){
+        for (int b = 0; b < MC_RANGE; b++){
+            signed char k = mc_pair_cache[a][b].load();
+            solved += k >= 0;
+            hard += k == 1;
+        }
+    }
+    printf("pair_table %lu/%d solved, %lu impossible\n", solved, MC_RANGE * MC_RANGE, hard);
+    printf("digest %016llx\n", (unsigned long long)digest);
+}
+
+int main(int argc, char **argv){
+    struct mc_options opt;
+    for (int i = 1; i < argc; i++){
+        const char *arg = argv[i];
+        const char *val = (i + 1 < argc) ? argv[i + 1] : NULL;
+        if (!strcmp(arg, "--scaling")){
+            opt.scaling = true;
+            continue;
+        }
+        if (!val){
+            fprintf(stderr, "usage: %s [--seeds N] [--first S] [--ticks T] [--threads N] [--noise P] [--delay D] [--scaling]\n", argv[0]);
+            return 2;
+        }
+        if      (!strcmp(arg, "--seeds"))   { opt.seeds = strtoul(val, NULL, 10); }
+        else if (!strcmp(arg, "--first"))   { opt.first = strtoul(val, NULL, 10); }
+        else if (!strcmp(arg, "--ticks"))   { opt.ticks = strtoul(val, NULL, 10); }
+        else if (!strcmp(arg, "--threads")) { opt.threads = strtoul(val, NULL, 10); }
+        else if (!strcmp(arg, "--noise"))   { opt.noise = atof(val); }
+        else if (!strcmp(arg, "--delay"))   { opt.delay = strtoul(val, NULL, 10); }
+        else {
+            fprintf(stderr, "unknown option %s\n", arg);
+            return 2;
+        }
+        i++;
+    }
+    if (opt.threads == 0){
+        opt.threads = 1;
+    }
+    for (int a = 0; a < MC_RANGE; a++){
+        for (int b = 0; b < MC_RANGE; b++){
+            mc_pair_cache[a][b].store(-1);
+        }
+    }
+
+    std::vector<struct mc_result> results;
+    if (opt.scaling){
+        //solve the pair table first so every thread count does the same simulation work
+        mc_batch(&opt, opt.threads, &results);
+        double base = 0;
+        for (unsigned int t = 1; ; t *= 2){
+            t = (t > opt.threads) ? opt.threads : t;
+            double dt = mc_batch(&opt, t, &results);
+            base = (t == 1) ? dt : base;
+            printf("threads %2u  %8.3f s  %8.0f seeds/s  speedup %5.2f  efficiency %5.1f%%\n", t, dt,
+                opt.seeds / dt, base / dt, 100.0 * base / dt / t);
+            if (t == opt.threads){
+                break;
+            }
+        }
+        mc_report(&opt, results);
+        return 0;
+    }
+
+    double dt = mc_batch(&opt, opt.threads, &results);
+    mc_report(&opt, results);
+    printf("threads %u  %.3f s  %.0f seeds/s\n", opt.threads, dt, opt.seeds / dt);
+    return 0;
+}
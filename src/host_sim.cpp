@@ -0,0 +1,1531 @@
+//HEADLESS HOST SIMULATION
+//runs the game core natively against the emulated peripherals in host/
+//
+//  host_sim bench [ticks] [--render]     scheduler cycles per second with the autopilot playing
+//  host_sim play <seed> [--render]       one autopilot run, prints death tick, score and height
+//  host_sim record <seed> <file>         records an autopilot run as a replay.h hex trace
+//  host_sim replay <file> [--render]     replays a trace dumped by the board ('d') or by record
+//                                        --no-diff sends every pixel in a SHADOW_FB build, for comparison
+//  host_sim longrec                      records a paused game until the trace closes itself at the
+//                                        16 bit end tick, then replays it
+//  host_sim snapshot [seed]              pauses an autopilot run, checks the EEPROM snapshot round trip,
+//                                        then resumes it on a fresh core and compares the two runs
+//  host_sim tft                          fills and blits odd and even windows, checks every pixel the
+//                                        panel decoded and reports bus bytes per pixel
+//  host_sim sprite                       blits random 1bpp and 2bpp sprites, plain and keyed, across the
+//                                        screen edges and checks every pixel against the source
+//  host_sim image                        draws every assets.h image whole and in random pieces, checks
+//                                        the pixels and the compiler's digest, reports compression
+//  host_sim font                         checks DrawText and the cached digits pixel by pixel, then the
+//                                        bus bytes the HUD sends for a full redraw, one digit and none
+//  host_sim sound                        plays every effect through the Timer0 ISR, checks lengths, the
+//                                        pin and preemption, then which effects a game run starts
+//  host_sim trace [file]                 EVENT_TRACE build: dumps the ring after a game run with 'f',
+//                                        checks that the spans nest, writes the dump for
+//                                        scripts/trace_to_chrome.py
+//  host_sim stress [seed] [us]           plays the same game with the panel bus at us a byte (48) for
+//                                        a stretch, load shedding off and on, checks the game is
+//                                        untouched and the renderer recovers, prints the counters
+//  host_sim scroll [seed]                ramps the scroll speed with the bird held in the gaps, checks
+//                                        the score and the panel every tick, then holds it in a pipe
+//                                        wall at every speed and checks it dies there
+//  host_sim swept                        swept_hits against TickDeath's old box test at one column a
+//                                        tick and against a fine walk faster, every case by one pipe
+//  host_sim remote                       the 't' reply and a button event against the tick TickButtons
+//                                        reads them on
+//  host_sim deadline [seed] [log]        hangs TickDraw mid-run, boots a fresh core on the .noinit
+//                                        record as the watchdog reset would, checks the report and
+//                                        that it comes back paused on the kept game, writes that
+//                                        boot's UART to log for scripts/deadline_check.py --log
+//  host_sim watchdog                     DEADLINE_TEST and EVENT_TRACE build: full buffers, then 'e',
+//                                        'd', 'f', 'o', 'm', checks the gaps between watchdog kicks
+
+#include "sim.h"
+#include <chrono>
+#include <ctype.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+double sim_seconds(){
+    using namespace std::chrono;
+    return duration<double>(steady_clock::now().time_since_epoch()).count();
+}
+
+bool has_flag(int argc, char **argv, const char *flag){
+    for (int i = 1; i < argc; i++){
+        if (!strcmp(argv[i], flag)){
+            return true;
+        }
+    }
+    return false;
+}
+
+void print_run(struct sim_run run){
+    if (run.death_tick){
+        printf("death_tick %lu score %d height %d\n", run.death_tick - run.start_tick, run.score, run.height);
+    }
+    else {
+        printf("alive after %lu ticks score %d height %d\n", tick_count - run.start_tick, run.score, run.height);
+    }
+}
+
+//FNV-1a of the panel, builds with another display bus must land on the same picture
+unsigned long long fb_digest(){
+    unsigned long long fb = 14695981039346656037ULL;
+    for (int y = 0; y < HOST_TFT_SIZE; y++){
+        for (int x = 0; x < HOST_TFT_SIZE; x++){
+            fb = (fb ^ host_tft.fb[y][x]) * 1099511628211ULL;
+        }
+    }
+    return fb;
+}
+
+int bench(unsigned long ticks){
+    unsigned long runs = 0;
+    unsigned long long score_sum = 0;
+    host_tft_clear_counters();
+    sim_tick_bytes_max = 0;
+
+    double t0 = sim_seconds();
+    unsigned long start = tick_count;
+    while (tick_count - start < ticks){
+        sim_reset(runs + 1);
+        struct sim_run run = sim_play(ticks - (tick_count - start));
+        score_sum += run.score;
+        runs++;
+    }
+    double dt = sim_seconds() - t0;
+    unsigned long done = tick_count - start;
+
+    printf("ticks %lu runs %lu mean_score %.2f\n", done, runs, runs ? (double)score_sum / runs : 0.0);
+    printf("ticks_per_sec %.0f (%.1fx real time)\n", done / dt, done / dt * GCD_PERIOD / 1000.0);
+    if (host_render){
+        printf("spi_bytes_per_tick %.1f\n", (double)host_tft.bytes / done);
+        printf("spi_bytes_max_tick %lu\n", sim_tick_bytes_max);
+        printf("framebuffer %016llx\n", fb_digest());
+    }
+    return 0;
+}
+
+int record(unsigned long seed, const char *path){
+    replay_mode = REPLAY_ARM_RECORD;
+    sim_reset(seed);
+    sim_start();
+
+    //play until death, or reset by hand while the worst case varint still fits
+    while (!sim_died()){
+        if (replay_len + 4 > REPLAY_SIZE){
+            remote_reset = true;
+        }
+        sim_buttons(false, sim_autopilot());
+        sim_tick();
+    }
+    sim_buttons(false, false);
+
+    if (!replay_valid()){
+        fprintf(stderr, "trace incomplete\n");
+        return 1;
+    }
+    FILE *f = fopen(path, "w");
+    if (!f){
+        perror(path);
+        return 1;
+    }
+    unsigned int len = REPLAY_HEADER + replay_get16(&replay_trace[2]);
+    fputc('T', f);
+    for (unsigned int i = 0; i < len; i++){
+        fprintf(f, "%02X", replay_trace[i]);
+    }
+    fputc('\n', f);
+    fclose(f);
+
+    printf("death_tick %u score %d height %d\n", replay_get16(&replay_trace[8]),
+        replay_get16(&replay_trace[10]), (int16_t)replay_get16(&replay_trace[12]));
+    printf("trace_bytes %u\n", len);
+    return 0;
+}
+
+//LONG RECORDING
+//a paused game recorded past REPLAY_MAX_TICKS, with a button flick now and then for long varint
+//deltas. the trace has to close itself at the cap, end tick and all, and replay to a match
+int longrec(){
+    replay_mode = REPLAY_ARM_RECORD;
+    sim_reset(3);
+    unsigned long start = tick_count;
+    while (replay_mode == REPLAY_RECORDING && tick_count - start < 2UL * REPLAY_MAX_TICKS){
+        sim_buttons(false, (tick_count - start) % 9000 == 4500);
+        sim_tick();
+    }
+    sim_buttons(false, false);
+    unsigned long ticks = tick_count - start;
+    if (!replay_valid() || replay_get16(&replay_trace[8]) != REPLAY_MAX_TICKS || ticks != REPLAY_MAX_TICKS){
+        fprintf(stderr, "the recording ran %lu ticks and stored end %u, it should close at %u\n",
+            ticks, replay_get16(&replay_trace[8]), REPLAY_MAX_TICKS);
+        return 1;
+    }
+
+    host_uart_out_len = 0;
+    replay_mode = REPLAY_ARM_PLAY;
+    remote_reset = true;
+    while (replay_mode == REPLAY_ARM_PLAY){
+        sim_tick();
+    }
+    start = tick_count;
+    while (replay_mode == REPLAY_PLAYING && tick_count - start < 2UL * REPLAY_MAX_TICKS){
+        sim_tick();
+    }
+    if (!strstr(host_uart_out, "R match") || tick_count - start != REPLAY_MAX_TICKS){
+        fprintf(stderr, "the replay ran %lu ticks:\n%s", tick_count - start, host_uart_out);
+        return 1;
+    }
+    printf("longrec ok: closed at %u ticks, %u event bytes, replayed to a match\n",
+        REPLAY_MAX_TICKS, replay_get16(&replay_trace[2]));
+    return 0;
+}
+
+int replay(const char *path){
+    FILE *f = fopen(path, "r");
+    if (!f){
+        perror(path);
+        return 1;
+    }
+    char line[2 * (REPLAY_HEADER + REPLAY_SIZE) + 4];
+    if (!fgets(line, sizeof(line), f) || line[0] != 'T'){
+        fprintf(stderr, "%s: not a trace dump\n", path);
+        fclose(f);
+        return 1;
+    }
+    fclose(f);
+    for (unsigned int i = 0; i < sizeof(replay_trace) && isxdigit(line[1 + 2*i]); i++){
+        unsigned int b;
+        sscanf(&line[1 + 2*i], "%2X", &b);
+        replay_trace[i] = b;
+    }
+    if (!replay_valid()){
+        fprintf(stderr, "%s: bad trace header\n", path);
+        return 1;
+    }
+
+    host_uart_out_len = 0;
+    replay_mode = REPLAY_ARM_PLAY;
+    remote_reset = true;
+    sim_buttons(false, false);
+
+    while (replay_mode == REPLAY_ARM_PLAY){
+        sim_tick(); //the reset tick starts playback
+    }
+
+    host_tft_clear_counters();
+    double t0 = sim_seconds();
+    unsigned long start = tick_count;
+    while (replay_mode == REPLAY_PLAYING && tick_count - start < 1000000UL){
+        sim_tick();
+    }
+    double dt = sim_seconds() - t0;
+
+    unsigned long ticks = tick_count - start;
+    printf("%s", host_uart_out);
+    printf("death_tick %u score %d height %d (recorded)\n", replay_get16(&replay_trace[8]),
+        replay_get16(&replay_trace[10]), (int16_t)replay_get16(&replay_trace[12]));
+    printf("replayed %lu ticks in %.3f ms (%.0fx real time)\n", ticks, dt * 1000, ticks * GCD_PERIOD / 1000.0 / dt);
+    if (host_render){
+        printf("spi_bytes_per_tick %.1f\n", (double)host_tft.bytes / ticks);
+        printf("framebuffer %016llx\n", fb_digest());
+#ifdef SHADOW_FB
+        printf("shadow framebuffer %zu bytes, skipping %s\n", sizeof(shadow_fb), shadow_diff ? "on" : "off");
+#endif
+    }
+    return strstr(host_uart_out, "R match") ? 0 : 1;
+}
+
+#define SNAPSHOT_MS_PER_BYTE 3.3 //ATmega328P EEPROM write time, the board reports its own measurement
+
+struct snapshot_step {
+    bool jump;
+    int height, score, frame;
+};
+
+//pauses with a tap of control and ticks until the snapshot write has finished
+//returns the bytes it wrote, -1 if no write came
+int snapshot_pause(){
+    host_uart_out_len = 0;
+    host_uart_out[0] = '\0';
+    sim_buttons(true, false);
+    sim_tick(); //a press on the tick jump is let go reads as no press, hold until the menu sees it
+    while (tasks[TASK_MENU].state == PLAYING){
+        sim_tick();
+    }
+    sim_buttons(false, false);
+    for (int t = 0; t < 10; t++){
+        sim_tick();
+        if (strstr(host_uart_out, "S saved")){
+            return snapshot_written;
+        }
+    }
+    return -1;
+}
+
+//ticks the recorded buttons from the paused screen, fills in what the core did with them
+void snapshot_follow(std::vector<struct snapshot_step> &steps){
+    sim_start();
+    for (struct snapshot_step &s : steps){
+        sim_buttons(false, s.jump);
+        sim_tick();
+        s.height = height;
+        s.score = sim_died() ? sim_last_score : score;
+        s.frame = frame;
+    }
+    sim_buttons(false, false);
+}
+
+int snapshot(unsigned long seed){
+    const unsigned long before = 300, after = 600;
+    sim_reset(seed);
+    sim_start();
+    for (unsigned long t = 0; t < before; t++){
+        sim_buttons(false, sim_autopilot());
+        sim_tick();
+        if (sim_died()){
+            fprintf(stderr, "seed %lu died before the pause, pick another\n", seed);
+            return 1;
+        }
+    }
+    int written = snapshot_pause();
+    if (written < 0){
+        fprintf(stderr, "no snapshot after the pause\n");
+        return 1;
+    }
+
+    //round trip: the stored payload is what the core packs, unpacking it packs the same bytes
+    uint8_t packed[SNAPSHOT_PAYLOAD_MAX], stored[SNAPSHOT_PAYLOAD_MAX], repacked[SNAPSHOT_PAYLOAD_MAX];
+    int len = snapshot_pack(packed);
+    int stored_len = snapshot_read(stored, sizeof(stored));
+    if (stored_len != len || memcmp(packed, stored, len)){
+        fprintf(stderr, "stored snapshot differs from the packed state\n");
+        return 1;
+    }
+    if (!snapshot_unpack(stored, stored_len) || snapshot_pack(repacked) != len || memcmp(packed, repacked, len)){
+        fprintf(stderr, "unpack/pack is not a round trip\n");
+        return 1;
+    }
+
+    //every single bit flip in the record is rejected
+    int record = SNAPSHOT_OVERHEAD + len;
+    for (int b = 0; b < record * 8; b++){
+        unsigned int addr = SNAPSHOT_EEPROM_ADDR + b / 8;
+        host_eeprom_inv[addr] ^= 1 << (b % 8);
+        bool accepted = snapshot_read(stored, sizeof(stored)) >= 0;
+        host_eeprom_inv[addr] ^= 1 << (b % 8);
+        if (accepted){
+            fprintf(stderr, "flipped bit %d of the record was accepted\n", b);
+            return 1;
+        }
+    }
+
+    //the power cycle: a fresh core on another thread sees only the EEPROM
+    std::vector<uint8_t> eeprom(host_eeprom_inv, host_eeprom_inv + HOST_EEPROM_SIZE);
+    bool resumed = false;
+    std::vector<struct snapshot_step> restored;
+
+    //the original plays on with the autopilot, its buttons are what the resumed core gets
+    std::vector<struct snapshot_step> original;
+    sim_start();
+    for (unsigned long t = 0; t < after; t++){
+        struct snapshot_step s;
+        s.jump = sim_autopilot();
+        sim_buttons(false, s.jump);
+        sim_tick();
+        s.height = height;
+        s.score = sim_died() ? sim_last_score : score;
+        s.frame = frame;
+        original.push_back(s);
+        if (sim_died()){
+            break;
+        }
+    }
+    sim_buttons(false, false);
+    restored = original;
+
+    std::thread board([&]{
+        memcpy(host_eeprom_inv, eeprom.data(), HOST_EEPROM_SIZE);
+        host_render = false;
+        rng_seed(seed + 1000); //a different boot seed, the snapshot's PRNG state must win
+        SPI_INIT();
+        serial_init(9600);
+        remote_init();
+        tasks_init();
+        resumed = snapshot_resume();
+        if (resumed){
+            scoreboard_init();
+            sim_tick(); //the first scheduler cycle only starts the task periods, as after any boot
+            snapshot_follow(restored);
+        }
+    });
+    board.join();
+    if (!resumed){
+        fprintf(stderr, "fresh core did not resume the snapshot\n");
+        return 1;
+    }
+    for (size_t t = 0; t < original.size(); t++){
+        const struct snapshot_step &a = original[t], &b = restored[t];
+        if (a.height != b.height || a.score != b.score || a.frame != b.frame){
+            fprintf(stderr, "resumed run diverged %zu ticks after the pause: height %d/%d score %d/%d frame %d/%d\n",
+                t, a.height, b.height, a.score, b.score, a.frame, b.frame);
+            return 1;
+        }
+    }
+
+    printf("snapshot ok: payload %d bytes, record %d bytes, %d flipped bits rejected\n", len, record, record * 8);
+    printf("resumed run matched the original for %zu ticks, score %d\n", original.size(), original.back().score);
+    printf("first write %d bytes (%.1f ms at %.1f ms/byte)\n", written, written * SNAPSHOT_MS_PER_BYTE, SNAPSHOT_MS_PER_BYTE);
+    if (!sim_died()){
+        int again = snapshot_pause();
+        printf("second pause %d bytes (%.1f ms), unchanged bytes are skipped\n", again, again * SNAPSHOT_MS_PER_BYTE);
+    }
+    return 0;
+}
+
+//what the panel shows for an RGB565 color in this build's color mode
+uint16_t tft_expected(uint16_t color){
+#ifdef TFT_COLOR_444
+    return host_tft_565(TFT_444(color));
+#else
+    return color;
+#endif
+}
+
+//the window must hold expect(i) in row order and nothing outside it may have changed
+bool tft_check(const char *what, uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1,
+               uint16_t (*fb_before)[HOST_TFT_SIZE], uint16_t (*expect)(int, uint16_t), uint16_t arg){
+    int i = 0;
+    for (int y = 0; y < HOST_TFT_SIZE; y++){
+        for (int x = 0; x < HOST_TFT_SIZE; x++){
+            bool inside = x >= x0 && x <= x1 && y >= y0 && y <= y1;
+            uint16_t want = inside ? expect(i++, arg) : fb_before[y][x];
+            if (host_tft.fb[y][x] != want){
+                fprintf(stderr, "%s %d,%d-%d,%d: pixel %d,%d is %04X, want %04X\n",
+                    what, x0, y0, x1, y1, x, y, host_tft.fb[y][x], want);
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+uint16_t tft_blit_pixels[HOST_TFT_SIZE * HOST_TFT_SIZE];
+
+uint16_t tft_fill_expect(int i, uint16_t color){
+    return tft_expected(color);
+}
+
+uint16_t tft_blit_expect(int i, uint16_t unused){
+    return tft_expected(tft_blit_pixels[i]);
+}
+
+int tft(){
+    static uint16_t before[HOST_TFT_SIZE][HOST_TFT_SIZE];
+    const uint16_t palette[] = {BLK, WHITE, RED, GREEN, 0x1234, 0xFEDC};
+    uint32_t x = 2463534242u;
+    unsigned long pixels = 0, fills = 0, blits = 0;
+    host_render = true;
+    host_tft_clear_counters();
+
+    for (int n = 0; n < 400; n++){
+        //odd and even sizes, single pixels and the full panel included
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        uint8_t w = (n < 4) ? (n % 2 ? 1 : HOST_TFT_SIZE) : x % 17 + 1;
+        uint8_t h = (n < 4) ? (n < 2 ? 1 : HOST_TFT_SIZE) : (x >> 8) % 13 + 1;
+        uint8_t x0 = (x >> 16) % (HOST_TFT_SIZE - w + 1);
+        uint8_t y0 = (x >> 24) % (HOST_TFT_SIZE - h + 1);
+        uint8_t x1 = x0 + w - 1, y1 = y0 + h - 1;
+        memcpy(before, host_tft.fb, sizeof(before));
+
+        if (n % 2 == 0){
+            uint16_t color = palette[n / 2 % 6];
+            SetWriteWindow(x0, y0, x1, y1);
+            FillWindow(x0, y0, x1, y1, color);
+            if (!tft_check("fill", x0, y0, x1, y1, before, tft_fill_expect, color)){
+                return 1;
+            }
+            fills++;
+        }
+        else {
+            for (int i = 0; i < w * h; i++){
+                x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+                tft_blit_pixels[i] = x;
+            }
+            BlitWindow(x0, y0, x1, y1, tft_blit_pixels);
+            if (!tft_check("blit", x0, y0, x1, y1, before, tft_blit_expect, 0)){
+                return 1;
+            }
+            blits++;
+        }
+        pixels += w * h;
+    }
+
+    //every window is CASET/RASET/RAMWR plus eight parameter bytes
+    unsigned long pixel_bytes = host_tft.bytes - host_tft.command_bytes - 8 * (fills + blits);
+    printf("tft ok: colmod 0x%02X, %lu fills, %lu blits, %lu pixels\n", host_tft.colmod, fills, blits, pixels);
+    printf("bus bytes %lu, pixel bytes %lu, %.3f per pixel\n", host_tft.bytes, pixel_bytes, (double)pixel_bytes / pixels);
+    return 0;
+}
+
+uint8_t sprite_data[SPRITE_HEADER + 40 * 40 * 2 / 8];
+
+int sprite(){
+    static uint16_t before[HOST_TFT_SIZE][HOST_TFT_SIZE];
+    uint16_t palette[4];
+    uint32_t x = 88675123u;
+    unsigned long blits = 0, keyed = 0, clipped = 0;
+    host_render = true;
+
+    //noise under the sprites, so a keyed blit that touched a clear pixel shows up
+    for (int i = 0; i < HOST_TFT_SIZE * HOST_TFT_SIZE; i++){
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        tft_blit_pixels[i] = x;
+    }
+    BlitWindow(XS, YS, XE, YE, tft_blit_pixels);
+
+    for (int n = 0; n < 600; n++){
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        uint8_t bpp = (n % 2) ? 2 : 1;
+        uint8_t w = x % 40 + 1, h = (x >> 8) % 40 + 1;
+        int sx = (int)((x >> 16) % (HOST_TFT_SIZE + 2 * 40)) - 40; //most cross an edge, some miss the panel
+        int sy = (int)((x >> 24) % (HOST_TFT_SIZE + 2 * 40)) - 40;
+        uint8_t flags = (n % 4 >= 2) ? SPRITE_KEYED : 0;
+        uint8_t stride = (w * bpp + 7) / 8;
+        sprite_data[0] = w;
+        sprite_data[1] = h;
+        sprite_data[2] = bpp;
+        for (int i = 0; i < stride * h; i++){
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            sprite_data[SPRITE_HEADER + i] = x >> 7;
+        }
+        for (int v = 0; v < 4; v++){
+            x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+            palette[v] = x;
+        }
+        memcpy(before, host_tft.fb, sizeof(before));
+        BlitSprite(sprite_data, sx, sy, palette, flags);
+
+        for (int y = 0; y < HOST_TFT_SIZE; y++){
+            for (int px = 0; px < HOST_TFT_SIZE; px++){
+                int c = px - sx, r = y - sy;
+                uint16_t want = before[y][px];
+                if (c >= 0 && c < w && r >= 0 && r < h){
+                    uint8_t v = sprite_value(&sprite_data[SPRITE_HEADER + r * stride], c, bpp);
+                    if (v != 0 || !flags){
+                        want = tft_expected(palette[v]);
+                    }
+                }
+                if (host_tft.fb[y][px] != want){
+                    fprintf(stderr, "sprite %dx%d %dbpp%s at %d,%d: pixel %d,%d is %04X, want %04X\n",
+                        w, h, bpp, flags ? " keyed" : "", sx, sy, px, y, host_tft.fb[y][px], want);
+                    return 1;
+                }
+            }
+        }
+        blits++;
+        keyed += flags ? 1 : 0;
+        clipped += (sx < XS || sy < YS || sx + w - 1 > XE || sy + h - 1 > YE) ? 1 : 0;
+    }
+
+    //the bird is the box TickDeath checks in this variant: every frame is its size, and the glide
+    //frame has pixels in its first and last row and column
+    for (unsigned int cnt = 0; cnt < 3; cnt++){
+        position_cnt = cnt;
+        const uint8_t *bird = bird_sprite();
+        uint8_t w = pgm_read_byte(bird), h = pgm_read_byte(bird + 1), stride = (w * 2 + 7) / 8;
+        if (w != BIRD_W || h != BIRD_H){
+            fprintf(stderr, "bird frame %u is %dx%d, the box is %dx%d\n", cnt, w, h, BIRD_W, BIRD_H);
+            return 1;
+        }
+        int left = w, right = -1, low = h, high = -1;
+        for (int r = 0; r < h; r++){
+            for (int c = 0; c < w; c++){
+                if (sprite_value(bird + SPRITE_HEADER + r * stride, c, 2)){
+                    left = std::min(left, c);
+                    right = std::max(right, c);
+                    low = std::min(low, r);
+                    high = std::max(high, r);
+                }
+            }
+        }
+        if (cnt == 0 && (left != 0 || right != w - 1 || low != 0 || high != h - 1)){
+            fprintf(stderr, "the gliding bird covers columns %d-%d and rows %d-%d of its %dx%d box\n",
+                left, right, low, high, w, h);
+            return 1;
+        }
+    }
+    position_cnt = 0;
+    printf("sprite ok: %lu blits, %lu keyed, %lu clipped, bird %dx%d\n", blits, keyed, clipped,
+        BIRD_W, BIRD_H);
+    return 0;
+}
+
+//plain decode of a run length image into RGB565, stream order
+int image_reference(const uint8_t *image, uint16_t *out){
+    int n = 0;
+    const uint8_t *run = image + RLE_HEADER + 2 * image[2];
+    while (n < image_pixels(image)){
+        uint8_t b = *run++;
+        int len = ((b & 0x0F) == RLE_LONG) ? RLE_LONG_MIN + *run++ : (b & 0x0F) + 1;
+        uint16_t color = image[RLE_HEADER + 2 * (b >> 4)] | (image[RLE_HEADER + 2 * (b >> 4) + 1] << 8);
+        for (int i = 0; i < len; i++){
+            out[n++] = color;
+        }
+    }
+    return run - image;
+}
+
+int image(){
+    struct { const char *name; const uint8_t *data; unsigned long long fnv; } images[] = {
+        {"background", asset_background, ASSET_BACKGROUND_FNV},
+        {"splash", asset_splash, ASSET_SPLASH_FNV},
+        {"gameover", asset_gameover, ASSET_GAMEOVER_FNV},
+    };
+    static uint16_t before[HOST_TFT_SIZE][HOST_TFT_SIZE];
+    uint32_t r = 123456789u;
+    host_render = true;
+
+    for (auto &img : images){
+        uint8_t w = img.data[0], h = img.data[1];
+        int size = image_reference(img.data, tft_blit_pixels);
+        unsigned long long fnv = 14695981039346656037ULL;
+        for (int i = 0; i < w * h; i++){
+            fnv = (fnv ^ tft_blit_pixels[i]) * 1099511628211ULL;
+        }
+        if (fnv != img.fnv){
+            fprintf(stderr, "image %s: digest %016llx, the compiler wrote %016llx\n", img.name, fnv, img.fnv);
+            return 1;
+        }
+
+        //whole, then in pieces of 1 to 300 pixels, odd ones included
+        for (int pass = 0; pass < 2; pass++){
+            uint8_t x0 = (HOST_TFT_SIZE - w) / 2, y0 = (HOST_TFT_SIZE - h) / 2;
+            FillBackground(GREEN);
+            memcpy(before, host_tft.fb, sizeof(before));
+            host_tft_clear_counters();
+            if (pass == 0){
+                DrawImage(img.data, x0, y0);
+            }
+            else {
+                struct image_stream st;
+                image_begin(&st, img.data, x0, y0);
+                do {
+                    r ^= r << 13; r ^= r >> 17; r ^= r << 5;
+                } while (image_continue(&st, r % 300 + 1) > 0);
+            }
+            if (!tft_check(img.name, x0, y0, x0 + w - 1, y0 + h - 1, before, tft_blit_expect, 0)){
+                return 1;
+            }
+        }
+        printf("image %-10s %3dx%-3d %5d bytes, %5.1fx smaller than RGB565, %d colors\n",
+            img.name, w, h, size, 2.0 * w * h / size, img.data[2]);
+    }
+    printf("image ok\n");
+    return 0;
+}
+
+//what DrawText should leave for str at (x, y)
+uint16_t font_expect_fg, font_expect_bg;
+const char *font_expect_str;
+
+uint16_t font_expect(int i, uint16_t w){
+    int c = i % w, r = i / w;
+    if (c % FONT_PITCH == FONT_COLS){
+        return tft_expected(font_expect_bg);
+    }
+    const uint8_t *glyph = font_glyph(font_expect_str[c / FONT_PITCH]);
+    return tft_expected(font_pixel(glyph, c % FONT_PITCH, r) ? font_expect_fg : font_expect_bg);
+}
+
+int font(){
+    static uint16_t before[HOST_TFT_SIZE][HOST_TFT_SIZE];
+    char text[FONT_LAST - FONT_FIRST + 2];
+    uint32_t x = 2463534242u;
+    host_render = true;
+
+    uint8_t most = font_cache_digits(PIPE_COLOR, BACKGROUND);
+    if (most > FONT_RUNS){
+        fprintf(stderr, "a digit takes %d runs, the cache holds %d\n", most, FONT_RUNS);
+        return 1;
+    }
+
+    //every glyph, in strings of random length and colors at random places, lowercase folded
+    for (int n = 0; n < 200; n++){
+        x ^= x << 13; x ^= x >> 17; x ^= x << 5;
+        int len = x % 21 + 1;
+        for (int i = 0; i < len; i++){
+            char ch = FONT_FIRST + (n * 7 + i) % (FONT_LAST - FONT_FIRST + 1);
+            text[i] = (i % 3 == 0 && ch >= 'A' && ch <= 'Z') ? ch + ('a' - 'A') : ch;
+        }
+        text[len] = '\0';
+        uint8_t w = len * FONT_PITCH - 1;
+        uint8_t tx = (x >> 8) % (HOST_TFT_SIZE - w + 1), ty = (x >> 16) % (HOST_TFT_SIZE - FONT_ROWS + 1);
+        font_expect_fg = x >> 3;
+        font_expect_bg = x >> 11;
+        font_expect_str = text;
+        FillBackground(GREEN);
+        memcpy(before, host_tft.fb, sizeof(before));
+        DrawText(tx, ty, text, font_expect_fg, font_expect_bg);
+        if (!tft_check("DrawText", tx, ty, tx + w - 1, ty + FONT_ROWS - 1, before, font_expect, w)){
+            return 1;
+        }
+    }
+
+    //a cached digit sends the same pixels as DrawText
+    font_expect_fg = PIPE_COLOR;
+    font_expect_bg = BACKGROUND;
+    for (int d = 0; d < 10; d++){
+        text[0] = '0' + d;
+        text[1] = '\0';
+        font_expect_str = text;
+        FillBackground(GREEN);
+        memcpy(before, host_tft.fb, sizeof(before));
+        DrawDigit(d, 40 + d, 60 - d);
+        if (!tft_check("DrawDigit", 40 + d, 60 - d, 40 + d + FONT_COLS - 1, 60 - d + FONT_ROWS - 1, before, font_expect, FONT_COLS)){
+            return 1;
+        }
+    }
+
+    //the HUD only sends what changed
+    FillBackground();
+    hud_invalidate();
+    hud_value[0] = 1234;
+    hud_value[1] = 98;
+    host_tft_clear_counters();
+    hud_draw();
+    unsigned long full = host_tft.bytes;
+    host_tft_clear_counters();
+    hud_value[0] = 1235;
+    hud_draw();
+    unsigned long one = host_tft.bytes;
+    host_tft_clear_counters();
+    hud_draw();
+    unsigned long none = host_tft.bytes;
+    if (none != 0 || one != 11 + TFT_PIXEL_BYTES(FONT_COLS * FONT_ROWS)){
+        fprintf(stderr, "hud sent %lu bytes for one digit and %lu for none\n", one, none);
+        return 1;
+    }
+    printf("font ok: 200 strings, 10 cached digits, %d runs at most of %d\n", most, FONT_RUNS);
+    printf("hud bytes: full redraw %lu, one digit %lu, unchanged %lu\n", full, one, none);
+    return 0;
+}
+
+//Timer0 as the board runs it, compare matches until ms have passed or the effect ended
+//returns the ms played and counts the pin's toggles
+double sound_run(double ms, unsigned long *toggles){
+    double t = 0;
+    while ((TCCR0B & 0x07) && t < ms){
+        double div = ((TCCR0B & 0x07) == SOUND_CS256) ? 256 : 64;
+        uint8_t pin = SOUND_PORT & SOUND_BIT;
+        t += div * (OCR0A + 1) * 1000.0 / F_CPU;
+        TIMER0_COMPA_vect();
+        *toggles += ((SOUND_PORT & SOUND_BIT) != pin) ? 1 : 0;
+    }
+    return t;
+}
+
+int sound(){
+    struct { const char *name; uint8_t id; double ms; } effects[] = {
+        {"jump", SOUND_JUMP, 50},
+        {"score", SOUND_SCORE, 110},
+        {"pause", SOUND_PAUSE, 130},
+        {"death", SOUND_DEATH, 570},
+    };
+    sound_init();
+    for (auto &e : effects){
+        unsigned long toggles = 0, edges = 0;
+        const uint8_t *step = (const uint8_t *)pgm_read_ptr(&sound_effects[e.id]);
+        for (; pgm_read_byte(step + 2) | pgm_read_byte(step + 3); step += SOUND_STEP){
+            edges += (pgm_read_byte(step + 1) & SOUND_SILENT) ? 0 : pgm_read_byte(step + 2) | (pgm_read_byte(step + 3) << 8);
+        }
+        sound_play(e.id);
+        double ms = sound_run(1000, &toggles);
+        if (sound_playing != SOUND_NONE || (TCCR0B & 0x07) || (TIMSK0 & (1 << OCIE0A)) || (SOUND_PORT & SOUND_BIT)){
+            fprintf(stderr, "sound %s did not stop with the timer off and the pin low\n", e.name);
+            return 1;
+        }
+        //each tone ends on a whole period, up to one short of its nominal length
+        if (ms < e.ms * 0.97 || ms > e.ms + 1 || toggles != edges){
+            fprintf(stderr, "sound %s: %.1f ms (want %.0f), %lu toggles (want %lu)\n", e.name, ms, e.ms, toggles, edges);
+            return 1;
+        }
+        printf("sound %-6s %6.1f ms, %4lu edges\n", e.name, ms, toggles);
+    }
+
+    //a lower effect never cuts in, an equal or higher one does
+    unsigned long toggles = 0;
+    sound_play(SOUND_DEATH);
+    sound_run(10, &toggles);
+    bool lower = sound_play(SOUND_JUMP);
+    bool still = sound_playing == SOUND_DEATH;
+    sound_stop();
+    sound_play(SOUND_JUMP);
+    bool higher = sound_play(SOUND_SCORE) && sound_playing == SOUND_SCORE;
+    bool again = sound_play(SOUND_SCORE);
+    sound_stop();
+    if (lower || !still || !higher || !again){
+        fprintf(stderr, "priorities: jump over death %d, death kept %d, score over jump %d, score again %d\n",
+            lower, still, higher, again);
+        return 1;
+    }
+
+    //an autopilot game, a scheduler cycle then 100 ms of Timer0. the autopilot pauses and resumes
+    //at 200 and lets go at 700 of every 1000 ticks, the bird falls to its death. every cycle has
+    //to give back the sources task_window_open masked, with the global flag off again
+    unsigned long started[5] = {0};
+    EEPROM_write_score(EEPROM_SCORE_ADDR, 0); //an erased best is 255, this run has to beat it
+    high_score = 0;
+    sim_reset(3);
+    sim_start();
+    TIMSK2 = (1 << OCIE2A);
+    UCSR0B |= (1 << RXCIE0);
+    cli();
+    for (int t = 0; t < 5000; t++){
+        bool control = t % 1000 == 200 || t % 1000 == 210;
+        bool jump = sim_autopilot();
+        sim_buttons(control, t % 1000 < 700 && jump);
+        sim_tick();
+        if (!(TIMSK2 & (1 << OCIE2A)) || !(UCSR0B & (1 << RXCIE0)) || (SREG & 0x80)){
+            fprintf(stderr, "tick %d: the task window left TIMSK2 %02X UCSR0B %02X SREG %02X\n",
+                t, TIMSK2, UCSR0B, SREG);
+            return 1;
+        }
+        uint8_t id = sound_playing;
+        const uint8_t *first = (const uint8_t *)pgm_read_ptr(&sound_effects[id]);
+        if (id != SOUND_NONE && sound_step == first &&
+            sound_left == (pgm_read_byte(first + 2) | (pgm_read_byte(first + 3) << 8))){
+            started[id]++;
+        }
+        sound_run(GCD_PERIOD, &toggles);
+        if (sim_died()){
+            sim_start();
+        }
+    }
+    printf("game run, 5000 ticks: jump %lu, score %lu, pause %lu, death %lu started\n",
+        started[SOUND_JUMP], started[SOUND_SCORE], started[SOUND_PAUSE], started[SOUND_DEATH]);
+    if (started[SOUND_JUMP] == 0 || started[SOUND_SCORE] == 0 || started[SOUND_PAUSE] == 0 || started[SOUND_DEATH] == 0){
+        fprintf(stderr, "every effect should have started\n");
+        return 1;
+    }
+    //TickMenu saves the best score and erases the snapshot on the RESETTING tick, inside the task
+    //window while the death tune plays. none of those writes may lose its EEMPE window to the ISR
+    if (host_eeprom_lost || EEPROM_read(EEPROM_SCORE_ADDR) != (uint8_t)high_score){
+        fprintf(stderr, "%lu EEPROM writes lost to the sound ISR, best %d stored as %d\n",
+            host_eeprom_lost, high_score, EEPROM_read(EEPROM_SCORE_ADDR));
+        return 1;
+    }
+    sound_play(SOUND_DEATH);
+    sei();
+    EEPROM_write_score(EEPROM_SCORE_ADDR, 0xA5);
+    cli();
+    if (EEPROM_read(EEPROM_SCORE_ADDR) != 0xA5){
+        fprintf(stderr, "a save with the death tune playing did not land\n");
+        return 1;
+    }
+    sound_stop();
+    printf("EEPROM saves land with the sound ISR on, best %d\n", high_score);
+    printf("sound ok\n");
+    return 0;
+}
+
+//decodes the 'f' dump, walks the spans like a call stack. the ring's first events may be the ends
+//of spans it cut, until the first scheduler cycle begins, and the cycle that dumped it is open
+int trace(const char *path){
+#ifndef EVENT_TRACE
+    fprintf(stderr, "trace needs a build with -DEVENT_TRACE\n");
+    return 2;
+#else
+    host_render = true;
+    sim_reset(3);
+    sim_start();
+    for (int t = 0; t < 300; t++){
+        sim_buttons(false, sim_autopilot());
+        sim_tick();
+        if (sim_died()){
+            sim_start();
+        }
+    }
+    host_uart_out_len = 0;
+    host_uart_out[0] = '\0';
+    sim_send("f");
+    sim_tick();
+
+    const char *line = strchr(host_uart_out, 'F');
+    if (!line){
+        fprintf(stderr, "no F line in the reply: %s\n", host_uart_out);
+        return 1;
+    }
+    std::vector<uint16_t> times;
+    std::vector<uint8_t> ids;
+    for (const char *p = line + 1; isxdigit(p[0]); p += 6){
+        unsigned int t, id;
+        sscanf(p, "%4X%2X", &t, &id);
+        times.push_back(t);
+        ids.push_back(id);
+    }
+    if (times.size() != EVENT_TRACE_SIZE){
+        fprintf(stderr, "%zu events, the ring holds %d and has wrapped\n", times.size(), EVENT_TRACE_SIZE);
+        return 1;
+    }
+
+    std::vector<uint8_t> open;
+    unsigned long spans = 0, marks = 0, cut = 0, cycles = 0, draws = 0;
+    size_t deepest = 0;
+    bool rooted = false; //a scheduler cycle has begun, every end from here on has its begin
+    for (size_t i = 0; i < ids.size(); i++){
+        uint8_t id = ids[i] & TRACE_ID_MASK;
+        if (id > TRACE_EEPROM || (id > TRACE_TASK + NUM_TASKS - 1 && id < TRACE_SCHED) ||
+            (ids[i] & TRACE_B && ids[i] & TRACE_E)){
+            fprintf(stderr, "event %zu: bad id %02X\n", i, ids[i]);
+            return 1;
+        }
+        if (i > 0 && (uint16_t)(times[i] - times[i - 1]) >= 0x8000){
+            fprintf(stderr, "event %zu: time went back\n", i);
+            return 1;
+        }
+        if (ids[i] & TRACE_B){
+            rooted = rooted || (open.empty() && id == TRACE_SCHED);
+            open.push_back(id);
+            deepest = open.size() > deepest ? open.size() : deepest;
+        }
+        else if (ids[i] & TRACE_E){
+            if (open.empty() && !rooted){
+                cut++;
+                continue;
+            }
+            if (open.empty() || open.back() != id){
+                fprintf(stderr, "event %zu: end of %d inside %d\n", i, id, open.empty() ? -1 : open.back());
+                return 1;
+            }
+            open.pop_back();
+            spans++;
+            cycles += id == TRACE_SCHED;
+            draws += id == TRACE_TASK + NUM_TASKS - 1;
+        }
+        else {
+            marks++;
+        }
+    }
+    if (open.size() != 1 || open[0] != TRACE_SCHED){
+        fprintf(stderr, "%zu spans left open, only the dumping cycle should be\n", open.size());
+        return 1;
+    }
+    if (path){
+        FILE *f = fopen(path, "w");
+        if (!f){
+            perror(path);
+            return 1;
+        }
+        fprintf(f, "%.*s\n", (int)(strchr(line, '\n') ? strchr(line, '\n') - line : strlen(line)), line);
+        fclose(f);
+    }
+    printf("trace %zu events: %lu spans, %lu marks, %lu cut by the ring, nesting %zu deep\n",
+        ids.size(), spans, marks, cut, deepest);
+    if (cycles == 0 || draws == 0){
+        fprintf(stderr, "the ring holds no whole scheduler cycle with a draw tick, one frame needs more than %d events\n",
+            EVENT_TRACE_SIZE);
+        return 1;
+    }
+    printf("trace ok: %lu whole scheduler cycles, %lu draw ticks\n", cycles, draws);
+    return 0;
+#endif
+}
+
+//DEADLINE MONITOR
+//the watchdog never fires here: the hung cycle is its deadline_begin and deadline_enter calls,
+//the reset is a fresh core on another thread that only gets the .noinit record and WDRF
+struct deadline_boot {
+    bool resumed;
+    std::string out;
+    uint8_t game[SNAPSHOT_PAYLOAD_MAX];
+    int len;
+    bool paused;
+};
+
+struct deadline_boot deadline_reboot(const struct deadline_record &rec, uint8_t mcusr){
+    struct deadline_boot boot;
+    std::thread board([&]{
+        host_render = false;
+        memcpy((void *)&deadline_rec, &rec, sizeof(rec));
+        deadline_mcusr = mcusr;
+        SPI_INIT();
+        serial_init(9600);
+        remote_init();
+        tasks_init();
+        boot.resumed = deadline_resume();
+        boot.out.assign(host_uart_out, host_uart_out_len);
+        boot.len = boot.resumed ? snapshot_pack(boot.game) : 0;
+        boot.paused = game_state == PAUSE && tasks[TASK_MENU].state == PAUSED;
+        if (boot.resumed){
+            scoreboard_init();
+            sim_tick();
+            sim_play(300); //and it plays on
+        }
+    });
+    board.join();
+    return boot;
+}
+
+int deadline(unsigned long seed, const char *log){
+    uint8_t kept[SNAPSHOT_PAYLOAD_MAX];
+    int kept_len = 0;
+    unsigned long kept_tick = 0;
+    deadline_start();
+    sim_reset(seed);
+    sim_start();
+    for (int t = 0; t < 300; t++){
+        sim_buttons(false, sim_autopilot());
+        sim_tick();
+        if (sim_died()){
+            fprintf(stderr, "seed %lu died before the hang, pick another\n", seed);
+            return 1;
+        }
+        if (tick_count % DEADLINE_KEEP == 0){
+            kept_len = snapshot_pack(kept);
+            kept_tick = tick_count;
+        }
+    }
+    //the cycle that never ends, TickDraw spins
+    unsigned long hung = tick_count + 1;
+    deadline_begin(hung);
+    deadline_enter(TASK_DRAW, hung);
+    struct deadline_record rec;
+    memcpy(&rec, (const void *)&deadline_rec, sizeof(rec));
+
+    char expect[64];
+    snprintf(expect, sizeof(expect), "W watchdog\nW task %d\nW tick %lu\nW resumed\n", TASK_DRAW, hung);
+    struct deadline_boot boot = deadline_reboot(rec, 1 << WDRF);
+    if (boot.out.find(expect) == std::string::npos){
+        fprintf(stderr, "expected the report\n%sgot\n%s", expect, boot.out.c_str());
+        return 1;
+    }
+    if (!boot.resumed || !boot.paused || boot.len != kept_len || memcmp(boot.game, kept, kept_len)){
+        fprintf(stderr, "the watchdog reset did not come back paused on the game kept at tick %lu\n", kept_tick);
+        return 1;
+    }
+    if (log){
+        FILE *f = fopen(log, "w");
+        if (!f){
+            perror(log);
+            return 1;
+        }
+        fputs(boot.out.c_str(), f); //the second boot's UART, for scripts/deadline_check.py --log
+        fclose(f);
+    }
+
+    //a power on finds the same bytes in RAM but no WDRF, a damaged copy reports and falls through
+    if (deadline_reboot(rec, 1 << PORF).resumed){
+        fprintf(stderr, "a power on resumed from the .noinit record\n");
+        return 1;
+    }
+    rec.game[5] ^= 0x10;
+    boot = deadline_reboot(rec, 1 << WDRF);
+    if (boot.resumed || boot.out.find("W lost") == std::string::npos){
+        fprintf(stderr, "a damaged game copy was not caught\n");
+        return 1;
+    }
+
+    printf("deadline ok: task %d tick %lu reported, resumed paused on the game from tick %lu\n",
+        TASK_DRAW, hung, kept_tick);
+    printf("power on and a damaged copy both start fresh\n");
+    return 0;
+}
+
+//WATCHDOG GAPS
+//DEADLINE_TEST build with EVENT_TRACE, the event ring wrapped and the replay trace full, then every
+//long remote command in its own cycle. the longest gap between kicks on the board clock (avr/wdt.h)
+//has to stay under the timeout, while 'e', 'd' and 'f' keep the cycle busy for longer than it
+int watchdog(){
+#if !defined(EVENT_TRACE) || !defined(DEADLINE_TEST)
+    fprintf(stderr, "watchdog needs a build with -DEVENT_TRACE -DDEADLINE_TEST\n");
+    return 2;
+#else
+    struct { const char *cmd; bool long_one; } cmds[] = {
+        {"e", true}, {"d", true}, {"f", true}, {"o", false}, {"m", false},
+    };
+    deadline_mcusr = 1 << WDRF; //the test firmware after its reset, TickDraw no longer hangs
+    deadline_start();
+    sim_reset(3);
+    sim_start();
+    for (int t = 0; t < 2000 && !trace_wrapped; t++){
+        sim_buttons(false, sim_autopilot());
+        sim_tick();
+        if (sim_died()){
+            sim_start();
+        }
+    }
+    if (!trace_wrapped){
+        fprintf(stderr, "the event ring never wrapped\n");
+        return 1;
+    }
+    replay_trace[0] = REPLAY_MAGIC; //a recording that ran out of room
+    replay_put16(&replay_trace[2], REPLAY_SIZE);
+
+    unsigned long long timeout = HOST_WDT_US(DEADLINE_TIMEOUT);
+    sim_tick();
+    for (auto &c : cmds){
+        host_uart_out_len = 0;
+        host_wdt_gap = 0;
+        unsigned long long waited = host_wait_us;
+        sim_send(c.cmd);
+        sim_tick();
+        unsigned long long busy = host_wait_us - waited;
+        printf("watchdog '%s': %5llu ms of UART and EEPROM, longest gap %5.1f ms of %llu\n",
+            c.cmd, busy / 1000, host_wdt_gap / 1000.0, timeout / 1000);
+        if (host_wdt_gap >= timeout){
+            fprintf(stderr, "'%s' went %llu us without a kick, the watchdog would reset the board\n",
+                c.cmd, host_wdt_gap);
+            return 1;
+        }
+        if (c.long_one && busy <= timeout){
+            fprintf(stderr, "'%s' was busy for %llu us, a full buffer should outlast the timeout\n", c.cmd, busy);
+            return 1;
+        }
+    }
+    printf("watchdog ok\n");
+    return 0;
+#endif
+}
+
+//STRESS RUN
+//the same autopilot game three times, each on a fresh core: the panel bus slowed down for a
+//stretch with load shedding off and on, then at full speed. drawing must not touch the game,
+//shedding must keep the cycles under the period, and once the bus is back it must recover
+//to level 0 with the picture the unstressed run has
+#define STRESS_TICKS 1400
+#define STRESS_FROM 300
+#define STRESS_TO 900
+#define STRESS_PAUSE 600 //paused for STRESS_PAUSED ticks from here, the cosmetic skips
+#define STRESS_PAUSED 20
+
+struct stress_run {
+    std::vector<struct snapshot_step> steps;
+    unsigned long frames[SHED_LEVELS];
+    unsigned long overruns, deferred, skipped, bytes;
+    uint16_t worst;
+    uint8_t level;
+    unsigned long long fb;
+};
+
+struct stress_run stress_play(unsigned long seed, unsigned int bus_us, bool shed){
+    struct stress_run run;
+    std::thread board([&]{
+        host_render = true;
+        sim_boot(1);
+        shed_enabled = shed;
+        sim_reset(seed);
+        sim_start();
+        host_tft_clear_counters();
+        for (unsigned long t = 0; t < STRESS_TICKS; t++){
+            host_bus_us_per_byte = (t >= STRESS_FROM && t < STRESS_TO) ? bus_us : 2;
+            if (t == STRESS_PAUSE){
+                sim_buttons(true, false);
+                sim_tick();
+                while (tasks[TASK_MENU].state == PLAYING){
+                    sim_tick();
+                }
+                sim_buttons(false, false);
+                for (int p = 0; p < STRESS_PAUSED; p++){
+                    sim_tick();
+                }
+                sim_start();
+            }
+            struct snapshot_step s;
+            s.jump = sim_autopilot();
+            sim_buttons(false, s.jump);
+            sim_tick();
+            s.height = height;
+            s.score = sim_died() ? sim_last_score : score;
+            s.frame = frame;
+            run.steps.push_back(s);
+            if (sim_died()){
+                sim_start();
+            }
+        }
+        memcpy(run.frames, shed_frames, sizeof(run.frames));
+        run.overruns = shed_overruns;
+        run.deferred = shed_deferred;
+        run.skipped = shed_skipped;
+        run.worst = shed_worst;
+        run.level = shed_level;
+        run.bytes = host_tft.bytes;
+        run.fb = fb_digest();
+    });
+    board.join();
+    return run;
+}
+
+void stress_print(const char *name, const struct stress_run &run){
+    printf("%-12s %8lu %9.1f %8.0f   %5lu %5lu %5lu %5lu %5lu %9lu %8lu\n", name, run.overruns,
+        run.worst * CLOCK_US_PER_COUNT / 1000.0, (double)run.bytes / STRESS_TICKS, run.frames[0], run.frames[1],
+        run.frames[2], run.frames[3], run.frames[4], run.deferred, run.skipped);
+}
+
+int stress(unsigned long seed, unsigned int bus_us){
+    struct stress_run off = stress_play(seed, bus_us, false);
+    struct stress_run on = stress_play(seed, bus_us, true);
+    struct stress_run calm = stress_play(seed, 2, true);
+
+    printf("bus %u us/byte for ticks %d-%d of %d, paused at %d, seed %lu\n",
+        bus_us, STRESS_FROM, STRESS_TO, STRESS_TICKS, STRESS_PAUSE, seed);
+    printf("%-12s %8s %9s %8s   %5s %5s %5s %5s %5s %9s %8s\n", "", "overruns", "worst_ms", "bytes/t",
+        "lvl0", "lvl1", "lvl2", "lvl3", "lvl4", "deferred", "skipped");
+    stress_print("no shedding", off);
+    stress_print("shedding", on);
+    stress_print("unstressed", calm);
+
+    for (size_t t = 0; t < calm.steps.size(); t++){
+        const struct snapshot_step &a = calm.steps[t], &b = off.steps[t], &c = on.steps[t];
+        if (a.height != b.height || a.height != c.height || a.score != b.score || a.score != c.score ||
+            a.frame != b.frame || a.frame != c.frame){
+            fprintf(stderr, "game state diverged at tick %zu: height %d/%d/%d score %d/%d/%d\n",
+                t, a.height, b.height, c.height, a.score, b.score, c.score);
+            return 1;
+        }
+    }
+    if (on.overruns >= off.overruns){
+        fprintf(stderr, "shedding did not cut the overruns\n");
+        return 1;
+    }
+    if (on.level != 0){
+        fprintf(stderr, "still at level %d after the bus came back\n", on.level);
+        return 1;
+    }
+    if (on.fb != calm.fb){
+        fprintf(stderr, "framebuffer %016llx differs from the unstressed %016llx\n", on.fb, calm.fb);
+        return 1;
+    }
+    printf("stress ok: game state matched for %d ticks, overruns %lu -> %lu, back at level 0 with the same picture\n",
+        STRESS_TICKS, off.overruns, on.overruns);
+    return 0;
+}
+
+//SCROLL SPEED
+//ramp: scroll_ramp climbs the speed to SCROLL_MAX with the bird held in the middle of each gap.
+//every tick the score has to count the pipe columns level_pos passed, and away from the pipes
+//and the bird the playfield must be blank, a jump that left a pipe behind shows up as ink
+//wall: the bird held in a pipe's wall at every speed up to SCROLL_MAX, a 16th of a column apart,
+//it has to die on that pipe, with the pipe inside its window
+#define SCROLL_TICKS 1500
+#define SCROLL_TEST_RAMP 16 //a 16th of a column a point, SCROLL_MAX by score 48
+
+//holds the bird at target after this tick's TickPosition
+void scroll_hold(int target){
+    position_speed = 0;
+    height = target + FALL_ACCEL;
+    sim_buttons(false, false);
+}
+
+//next pipe that can still touch the bird, a SHADOW_FB build tests the caps too
+int scroll_next_pipe(){
+    for (int k = -(PLAYER_SIZE/2 + pgm_read_byte(pipe_cap)); k < PIPE_SPACING; k++){
+        int i = (frame + k + LEVEL_SIZE) % LEVEL_SIZE;
+        if (columns[i].has_pipe){
+            return i;
+        }
+    }
+    return -1;
+}
+
+//pipe pixels away from any pipe column or the bird, -1 if there are none
+int scroll_stale_column(){
+    bool near[HOST_TFT_SIZE] = {false};
+    for (int x = PLAYER_OFFSET - PLAYER_SIZE/2; x <= PLAYER_OFFSET + PLAYER_SIZE/2; x++){
+        near[x] = true;
+    }
+    for (int i = 0; i < LEVEL_SIZE; i++){
+        int pos = columns[i].has_pipe ? pipe_screen_pos(i) : -1;
+        for (int x = pos - PIPE_CAP_LEFT; pos >= 0 && x < pos - PIPE_CAP_LEFT + pgm_read_byte(pipe_cap); x++){
+            near[(x < 0) ? 0 : x] = true;
+        }
+    }
+    //the renderer leaves a pipe's last draw at column 0
+    for (int x = PIPE_CAP_LEFT + 2; x < LEVEL_SIZE; x++){
+        for (int y = YS; !near[x] && y <= PIPE_TOP; y++){
+            if (host_tft.fb[y][x] != tft_expected(BACKGROUND)){
+                return x;
+            }
+        }
+    }
+    return -1;
+}
+
+int scroll_ramp_run(unsigned long seed){
+    int failed = 0;
+    std::thread board([&]{
+        host_render = true;
+        sim_boot(1);
+        sim_reset(seed);
+        sim_start();
+        scroll_ramp = SCROLL_TEST_RAMP;
+        int expect = 0;
+        unsigned long bytes[SCROLL_MAX / 256 + 1] = {0}, ticks[SCROLL_MAX / 256 + 1] = {0};
+        for (int t = 0; t < SCROLL_TICKS && !failed; t++){
+            int pipe = scroll_next_pipe();
+            scroll_hold((pipe < 0) ? 64 : columns[pipe].bottom + columns[pipe].gap / 2);
+            int from = level_pos;
+            unsigned long before = host_tft.bytes;
+            sim_tick();
+            for (int c = 0; c < level_step; c++){
+                int i = (from + c) % LEVEL_SIZE;
+                expect += (i % PIPE_SPACING == 1);
+            }
+            bytes[level_step] += host_tft.bytes - before;
+            ticks[level_step]++;
+
+            int stale = (tasks[TASK_DRAW].state == DRAW) ? scroll_stale_column() : -1;
+            if (sim_died() || score != expect || stale >= 0){
+                fprintf(stderr, "tick %d, %d columns a tick: %s score %d want %d, stale column %d\n", t,
+                    level_step, sim_died() ? "died," : "", sim_died() ? sim_last_score : score, expect, stale);
+                failed = 1;
+            }
+        }
+        if (!failed && ticks[SCROLL_MAX / 256] == 0){
+            fprintf(stderr, "never reached %d columns a tick, score %d\n", SCROLL_MAX / 256, score);
+            failed = 1;
+        }
+        printf("ramp %d: score %d after %d ticks, no stale columns\n", SCROLL_TEST_RAMP, score, SCROLL_TICKS);
+        printf("columns/tick   ticks   bytes/tick\n");
+        for (int c = 1; c <= SCROLL_MAX / 256; c++){
+            printf("%12d %7lu %12.1f\n", c, ticks[c], ticks[c] ? (double)bytes[c] / ticks[c] : 0.0);
+        }
+    });
+    board.join();
+    return failed;
+}
+
+//the frame TickDeath used against the pipe it died on, -1 if it never died
+int scroll_wall_run(unsigned long seed, int points, int *pipe){
+    sim_reset(seed);
+    sim_start();
+    scroll_ramp = SCROLL_TEST_RAMP;
+    score = points;
+    *pipe = -1;
+    for (int t = 0; t < 2 * LEVEL_SIZE; t++){
+        int next = scroll_next_pipe();
+        *pipe = (*pipe < 0) ? next : *pipe;
+        scroll_hold((next < 0) ? 64 : columns[next].bottom - PLAYER_SIZE/2);
+        int used = frame;
+        sim_tick();
+        if (sim_died()){
+            return used;
+        }
+    }
+    return -1;
+}
+
+int scroll(unsigned long seed){
+    if (scroll_ramp_run(seed)){
+        return 1;
+    }
+    int reach = PLAYER_SIZE/2 + pgm_read_byte(pipe_cap);
+    int points = 0;
+    for (; SCROLL_BASE + SCROLL_TEST_RAMP * points <= SCROLL_MAX; points++){
+        int pipe;
+        int used = scroll_wall_run(seed, points, &pipe);
+        int d = (used - pipe + LEVEL_SIZE + LEVEL_SIZE / 2) % LEVEL_SIZE - LEVEL_SIZE / 2;
+        if (used < 0 || d < -reach || d > reach){
+            fprintf(stderr, "%.4f columns a tick: held in the wall of column %d, %s %d\n",
+                (SCROLL_BASE + SCROLL_TEST_RAMP * points) / 256.0, pipe, used < 0 ? "never died, frame" : "died at frame", used < 0 ? frame : used);
+            return 1;
+        }
+    }
+    printf("wall: died on the pipe at all %d speeds from 1 to %d columns a tick\n", points, SCROLL_MAX / 256);
+    printf("scroll ok\n");
+    return 0;
+}
+
+//SWEPT COLLISION
+//every case swept_hits can meet near one pipe: the last frame, the pipe's column around the
+//bird, both heights around the gap. the test only sees heights against the bottom, so bottoms
+//are create_level's lowest, middle and highest
+//  one column a tick or none, after a check the bird survived: the same answer as the box test
+//  TickDeath made before, the loop below
+//  faster, after a check the bird survived: the same answer as the bird walked along the line in
+//  16ths of a column. and never alive where the box test at the new position says dead
+#define SWEPT_FINE 16
+#define SWEPT_REACH (PLAYER_SIZE/2 + 3)   //pipe columns tried either side of the bird
+#define SWEPT_SLACK 4                     //heights tried outside the gap
+
+//TickDeath's box test before the sweep, frame f and height h
+bool swept_box(int f, int h){
+    for (int i = f - PLAYER_SIZE/2; i < f + PLAYER_SIZE/2 + 1; i++){
+        int wrapped_i = (i < 0) ? i + LEVEL_SIZE : (i >= LEVEL_SIZE) ? i - LEVEL_SIZE : i;
+        column check_column = columns[wrapped_i];
+        if (check_column.has_pipe && (h - PLAYER_SIZE/4 + 1 < check_column.bottom || (check_column.bottom + check_column.gap) < h + PLAYER_SIZE/4)){
+            return true;
+        }
+    }
+    return false;
+}
+
+//the bird walked from (f0, h0) s columns on in 1/SWEPT_FINE steps, the start left out
+bool swept_walk(int f0, int h0, int s, int h1, int pipe){
+    int fine = s * SWEPT_FINE;
+    int d = (pipe - f0 + LEVEL_SIZE + LEVEL_SIZE / 2) % LEVEL_SIZE - LEVEL_SIZE / 2;
+    for (int k = 1; k <= fine; k++){
+        //bird at f0 + k / SWEPT_FINE, height h0 + (h1 - h0) k / fine, all times fine
+        int x = d * SWEPT_FINE - k;
+        int h = h0 * fine + (h1 - h0) * k;
+        if (x >= -PLAYER_SIZE/2 * SWEPT_FINE && x <= PLAYER_SIZE/2 * SWEPT_FINE && pipe_hits(columns[pipe], h, fine)){
+            return true;
+        }
+    }
+    return false;
+}
+
+int swept(){
+    for (int c = 0; c < LEVEL_SIZE; c++){
+        columns[c].has_pipe = false;
+        columns[c].bottom = -1;
+    }
+    unsigned long cases = 0, same = 0, caught = 0;
+    int fastest = (SCROLL_MAX + 255) / 256;
+    for (int f0 = 0; f0 < LEVEL_SIZE; f0++){
+        for (int d = -SWEPT_REACH - fastest; d <= SWEPT_REACH; d++){
+            int pipe = (f0 + d + LEVEL_SIZE) % LEVEL_SIZE;
+            columns[pipe].has_pipe = true;
+            for (int b = GAP_MIN; b <= GAP_MAX; b += (GAP_MAX - GAP_MIN) / 2){
+                columns[pipe].bottom = b;
+                for (int h0 = b - SWEPT_SLACK; h0 <= b + GAP + SWEPT_SLACK; h0++){
+                    bool alive = !swept_box(f0, h0);
+                    for (int h1 = b - SWEPT_SLACK; h1 <= b + GAP + SWEPT_SLACK; h1++){
+                        for (int s = 0; s <= fastest; s++){
+                            int f1 = (f0 + s) % LEVEL_SIZE;
+                            bool hit = swept_hits(f0, h0, f1, h1);
+                            bool box = swept_box(f1, h1);
+                            cases++;
+                            if (s <= 1){
+                                if (alive && hit != box){
+                                    fprintf(stderr, "%d columns from frame %d, height %d to %d, pipe %d bottom %d: swept %d, box %d\n",
+                                        s, f0, h0, h1, pipe, b, hit, box);
+                                    return 1;
+                                }
+                                same += alive;
+                                continue;
+                            }
+                            bool walk = swept_walk(f0, h0, s, h1, pipe);
+                            if ((alive && hit != walk) || (box && !hit)){
+                                fprintf(stderr, "%d columns from frame %d, height %d to %d, pipe %d bottom %d: swept %d, walked %d, box %d\n",
+                                    s, f0, h0, h1, pipe, b, hit, walk, box);
+                                return 1;
+                            }
+                            caught += alive && hit && !box;
+                        }
+                    }
+                }
+            }
+            columns[pipe].has_pipe = false;
+            columns[pipe].bottom = -1;
+        }
+    }
+    printf("swept ok: %lu cases, %lu at 0 or 1 columns a tick matched the box test\n", cases, same);
+    printf("%lu at 2 to %d columns a tick matched the walk and died where the box test missed it\n", caught, fastest);
+    return 0;
+}
+
+//REMOTE TICKS
+//'t' names the tick the cycle's tasks run on, an event for tick t is what read_buttons gives on t
+int remote(){
+    sim_reset(3);
+    sim_start();
+    host_uart_out_len = 0;
+    sim_send("t");
+    sim_tick();
+    unsigned long told = strtoul(host_uart_out, NULL, 10);
+    if (told != tick_count){
+        fprintf(stderr, "'t' replied %lu in the cycle that ran tick %lu\n", told, tick_count);
+        return 1;
+    }
+    unsigned long at = tick_count + 5;
+    char line[24];
+    snprintf(line, sizeof(line), "j%lu,1", at);
+    sim_send(line);
+    while (tick_count < at){
+        sim_tick();
+        bool down = remote_buttons(0) & 0x02;
+        if (down != (tick_count == at)){
+            fprintf(stderr, "the jump for tick %lu was %s on tick %lu\n", at, down ? "down" : "up", tick_count);
+            return 1;
+        }
+    }
+    printf("remote ok: 't' and a jump event land on the tick TickButtons reads\n");
+    return 0;
+}
+
+int main(int argc, char **argv){
+    if (argc < 2){
+        fprintf(stderr, "usage: %s bench [ticks] | play <seed> | record <seed> <file> | replay <file> | longrec | snapshot [seed] | tft | sprite | image | font | sound | trace [file] | stress [seed] [us] | scroll [seed] | swept | remote | deadline [seed] [log] | watchdog\n", argv[0]);
+        return 2;
+    }
+    host_render = has_flag(argc, argv, "--render");
+#ifdef SHADOW_FB
+    shadow_diff = !has_flag(argc, argv, "--no-diff");
+#endif
+    sim_boot(1);
+
+    if (!strcmp(argv[1], "bench")){
+        return bench(argc > 2 && isdigit(argv[2][0]) ? strtoul(argv[2], NULL, 10) : 10000000UL);
+    }
+    if (!strcmp(argv[1], "play") && argc > 2){
+        sim_reset(strtoul(argv[2], NULL, 10));
+        print_run(sim_play(1000000UL));
+        return 0;
+    }
+    if (!strcmp(argv[1], "record") && argc > 3){
+        return record(strtoul(argv[2], NULL, 10), argv[3]);
+    }
+    if (!strcmp(argv[1], "replay") && argc > 2){
+        return replay(argv[2]);
+    }
+    if (!strcmp(argv[1], "longrec")){
+        return longrec();
+    }
+    if (!strcmp(argv[1], "tft")){
+        return tft();
+    }
+    if (!strcmp(argv[1], "sprite")){
+        return sprite();
+    }
+    if (!strcmp(argv[1], "image")){
+        return image();
+    }
+    if (!strcmp(argv[1], "font")){
+        return font();
+    }
+    if (!strcmp(argv[1], "sound")){
+        return sound();
+    }
+    if (!strcmp(argv[1], "trace")){
+        return trace(argc > 2 && argv[2][0] != '-' ? argv[2] : NULL);
+    }
+    if (!strcmp(argv[1], "remote")){
+        return remote();
+    }
+    if (!strcmp(argv[1], "deadline")){
+        bool seeded = argc > 2 && isdigit(argv[2][0]);
+        return deadline(seeded ? strtoul(argv[2], NULL, 10) : 3, argc > (seeded ? 3 : 2) ? argv[seeded ? 3 : 2] : NULL);
+    }
+    if (!strcmp(argv[1], "watchdog")){
+        return watchdog();
+    }
+    if (!strcmp(argv[1], "scroll")){
+        return scroll(argc > 2 && isdigit(argv[2][0]) ? strtoul(argv[2], NULL, 10) : 3);
+    }
+    if (!strcmp(argv[1], "swept")){
+        return swept();
+    }
+    if (!strcmp(argv[1], "stress")){
+        return stress(argc > 2 && isdigit(argv[2][0]) ? strtoul(argv[2], NULL, 10) : 3,
+            argc > 3 && isdigit(argv[3][0]) ? strtoul(argv[3], NULL, 10) : 48);
+    }
+    if (!strcmp(argv[1], "snapshot")){
+        return snapshot(argc > 2 && isdigit(argv[2][0]) ? strtoul(argv[2], NULL, 10) : 3);
+    }
+    fprintf(stderr, "unknown command %s\n", argv[1]);
+    return 2;
+}